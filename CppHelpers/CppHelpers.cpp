@@ -46,9 +46,6 @@
 
 typedef DWORD ARGB;
 
-static const WCHAR BACKSLASH{ '\\' };
-static const WCHAR QUOTE{ '\"' };
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace hlp
@@ -61,6 +58,36 @@ namespace hlp
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool CopyToClipboard(HWND hWndNewOwner, LPCVOID pData, SIZE_T nBytes, UINT uFormat)
+	{
+		SystemClipboardBackend backend{};
+		ClipboardTransaction transaction{ backend };
+
+		return transaction.Open(hWndNewOwner) && transaction.SetData(uFormat, pData, nBytes);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool CopyToClipboard(HWND hWndNewOwner, const std::wstring& str)
+	{
+		SystemClipboardBackend backend{};
+		ClipboardTransaction transaction{ backend };
+
+		return transaction.Open(hWndNewOwner) && transaction.SetText(str);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SystemClipboardBackend::Open(HWND hWndNewOwner)
+	{
+		return OpenClipboard(hWndNewOwner) != FALSE;
+	}
+
+	bool SystemClipboardBackend::Empty()
+	{
+		return EmptyClipboard() != FALSE;
+	}
+
+	bool SystemClipboardBackend::SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer)
 	{
 		auto succeeded{ false };
 
@@ -70,18 +97,11 @@ namespace hlp
 			auto pMem{ GlobalLock(hGlobal) };
 			if (pMem != nullptr)
 			{
-				memcpy(pMem, pData, nBytes);
+				auto written{ writer(pMem, nBytes) };
 				GlobalUnlock(hGlobal);
 
-				if (OpenClipboard(hWndNewOwner))
-				{
-					if (EmptyClipboard())
-					{
-						succeeded = SetClipboardData(uFormat, hGlobal) != nullptr;
-					}
-
-					CloseClipboard();
-				}
+				// The clipboard owns the memory block once SetClipboardData succeeds.
+				succeeded = written && SetClipboardData(uFormat, hGlobal) != nullptr;
 			}
 
 			if (!succeeded)
@@ -93,21 +113,24 @@ namespace hlp
 		return succeeded;
 	}
 
-	///////////////////////////////////////////////////////////////////////////////////////////////////
-
-	bool CopyToClipboard(HWND hWndNewOwner, const std::wstring& str)
+	bool SystemClipboardBackend::SetDelayedData(UINT uFormat)
 	{
-		auto nBytes{ (str.length() + 1) * sizeof(WCHAR) };
-		return CopyToClipboard(hWndNewOwner, str.c_str(), nBytes, CF_UNICODETEXT);
-	}
+		// SetClipboardData returns nullptr for delayed rendering, a failure is only reported by GetLastError.
+		SetLastError(ERROR_SUCCESS);
+		SetClipboardData(uFormat, nullptr);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      CodeTiming
-	//
-	///////////////////////////////////////////////////////////////////////////////////////////////
+		return GetLastError() == ERROR_SUCCESS;
+	}
 
+	void SystemClipboardBackend::Close()
+	{
+		CloseClipboard();
+	}
 
+	bool SystemClipboardBackend::IsOwner(HWND hWnd)
+	{
+		return GetClipboardOwner() == hWnd;
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
@@ -130,68 +153,52 @@ namespace hlp
 
 #pragma warning(suppress: 26495) // stgm_ doesn't need to be initialized.
 
-	DropFilesList::DropFilesList() : pList_{ nullptr }
+	DataObjectDropFilesList::DataObjectDropFilesList() : fMedium_{ false }
 	{
 	}
 
-	DropFilesList::~DropFilesList()
+	DataObjectDropFilesList::~DataObjectDropFilesList()
 	{
 		Unload();
 	}
 
 	// https://docs.microsoft.com/en-us/windows/desktop/shell/clipboard#cf_hdrop
-	bool DropFilesList::Load(LPDATAOBJECT pDataObject)
+	bool DataObjectDropFilesList::Load(LPDATAOBJECT pDataObject)
 	{
+		TraceScope trace{ L"DataObjectDropFilesList::Load" };
+
 		Unload();
 
 		FORMATETC fetc{ CF_HDROP, nullptr, DVASPECT_CONTENT, -1, TYMED_HGLOBAL };
 		if (SUCCEEDED(pDataObject->GetData(&fetc, &stgm_)))
 		{
-			auto pDropFiles{ static_cast<DROPFILES*>(stgm_.hGlobal) };
-			pList_ = reinterpret_cast<LPCWSTR>((BYTE*)pDropFiles + pDropFiles->pFiles);
-			fWide_ = pDropFiles->fWide;
-		}
+			auto pData{ GlobalLock(stgm_.hGlobal) };
+			fMedium_ = pData != nullptr && Attach(pData, GlobalSize(stgm_.hGlobal));
 
-		return pList_ != nullptr;
-	}
-
-	void DropFilesList::Unload()
-	{
-		if (pList_ != nullptr)
-		{
-			pList_ = nullptr;
-			ReleaseStgMedium(&stgm_);
-		}
-	}
+			if (!fMedium_)
+			{
+				if (pData != nullptr)
+				{
+					GlobalUnlock(stgm_.hGlobal);
+				}
 
-	bool DropFilesList::IsMultiItems() const
-	{
-		if (fWide_)
-		{
-			return IsMultiSzItems(pList_);
+				ReleaseStgMedium(&stgm_);
+			}
 		}
 
-		return IsMultiSzItems(reinterpret_cast<LPCSTR>(pList_));
+		return pList_ != nullptr;
 	}
 
-	std::wstring DropFilesList::GetFirstItem() const
+	void DataObjectDropFilesList::Unload()
 	{
-		if (fWide_)
-		{
-			return std::wstring{ pList_ };
-		}
-
-		return WStrFromStr(reinterpret_cast<LPCSTR>(pList_));
-	}
+		DropFilesList::Unload();
 
-	std::vector<std::wstring> DropFilesList::GetItems() const
-	{
-		if (fWide_)
+		if (fMedium_)
 		{
-			return GetMultiSzItems(pList_);
+			GlobalUnlock(stgm_.hGlobal);
+			ReleaseStgMedium(&stgm_);
+			fMedium_ = false;
 		}
-
-		return GetMultiSzItemsWide(reinterpret_cast<LPCSTR>(pList_));
 	}
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -259,19 +266,25 @@ namespace hlp
 
 	std::wstring DeviceInformationSet::GetDevicePath(LPCWSTR pDeviceName) const
 	{
+		TraceScope trace{ L"DeviceInformationSet::GetDevicePath" };
+
 		if (hDevInfo_ != INVALID_HANDLE_VALUE)
 		{
 			StorageDeviceNumber deviceSdn;
 			if (deviceSdn.Load(pDeviceName))
 			{
+				StringArena devicePaths;
+				GetDevicePaths(devicePaths);
+
 				StorageDeviceNumber disSdn;
-				for (const auto& devicePath : GetDevicePaths())
+				for (const auto& devicePath : devicePaths)
 				{
-					if (disSdn.Load(devicePath.c_str()))
+					// The stored strings are null-terminated.
+					if (disSdn.Load(devicePath.data()))
 					{
 						if (disSdn.DeviceNumber() == deviceSdn.DeviceNumber())
 						{
-							return devicePath;
+							return std::wstring{ devicePath };
 						}
 					}
 				}
@@ -285,6 +298,27 @@ namespace hlp
 	{
 		std::vector<std::wstring> devicePaths{};
 
+		if (!EnumerateDevicePaths([&devicePaths](LPCWSTR pDevicePath) { devicePaths.push_back(std::wstring{ pDevicePath }); }))
+		{
+			devicePaths.clear();
+		}
+
+		return devicePaths;
+	}
+
+	void DeviceInformationSet::GetDevicePaths(StringArena& devicePaths) const
+	{
+		auto size{ devicePaths.size() };
+
+		if (!EnumerateDevicePaths([&devicePaths](LPCWSTR pDevicePath) { devicePaths.Add(pDevicePath); }))
+		{
+			devicePaths.Truncate(size);
+		}
+	}
+
+	template <typename Callback>
+	bool DeviceInformationSet::EnumerateDevicePaths(Callback callback) const
+	{
 		if (hDevInfo_ != INVALID_HANDLE_VALUE)
 		{
 			SP_DEVICE_INTERFACE_DATA diData{ sizeof(SP_DEVICE_INTERFACE_DATA) };
@@ -297,8 +331,7 @@ namespace hlp
 				SetupDiGetDeviceInterfaceDetailW(hDevInfo_, &diData, nullptr, 0, &requiredSize, nullptr);
 				if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
 				{
-					devicePaths.clear();
-					break;
+					return false;
 				}
 
 				auto buffer{ std::make_unique<BYTE[]>(requiredSize) };
@@ -307,15 +340,14 @@ namespace hlp
 
 				if (!SetupDiGetDeviceInterfaceDetailW(hDevInfo_, &diData, pDiDetailData, requiredSize, nullptr, nullptr))
 				{
-					devicePaths.clear();
-					break;
+					return false;
 				}
 
-				devicePaths.push_back(std::wstring{ pDiDetailData->DevicePath });
+				callback(pDiDetailData->DevicePath);
 			}
 		}
 
-		return devicePaths;
+		return true;
 	}
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -477,8 +509,7 @@ namespace hlp
 	{
 		if (offset != 0)
 		{
-			auto pStr{ reinterpret_cast<LPCSTR>((BYTE*)pDescriptor_ + offset) };
-			return std::wstring{ pStr, pStr + strlen(pStr) };
+			return WStrFromStr(reinterpret_cast<LPCSTR>((BYTE*)pDescriptor_ + offset), CP_ACP);
 		}
 
 		return std::wstring{};
@@ -600,47 +631,6 @@ namespace hlp
 		pVolDiskExt_ = reinterpret_cast<PVOLUME_DISK_EXTENTS>(volDiskExtBuffer_.get());
 	}
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      environment
-	//
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// https://docs.microsoft.com/en-us/cpp/cpp/parsing-cpp-command-line-arguments
-	std::wstring EscapeArgument(std::wstring argument)
-	{
-		if (!argument.empty())
-		{
-			if (argument.find_first_of(L" \"\t") == argument.npos)
-			{
-				return argument;
-			}
-
-			argument.reserve(argument.length() * 2);
-			auto index{ argument.length() };
-			auto quote{ true };
-
-			while (--index != argument.npos)
-			{
-				if (quote && argument[index] == BACKSLASH)
-				{
-					argument.insert(index, 1, BACKSLASH);
-				}
-				else if (argument[index] == QUOTE)
-				{
-					argument.insert(index, 1, BACKSLASH);
-					quote = true;
-				}
-				else if (quote == true)
-				{
-					quote = false;
-				}
-			}
-		}
-
-		return std::wstring{ QUOTE + argument + QUOTE };
-	}
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      image
@@ -802,28 +792,22 @@ namespace hlp
 		LPWSTR path;
 		if (SUCCEEDED(SHGetKnownFolderPath(knownFolder, KF_FLAG_DEFAULT, nullptr, &path)))
 		{
-			filePath = path;
+			std::wstring_view folder{ path };
+			filePath.reserve(folder.length() + (subdirName.empty() ? 0 : subdirName.length() + 1) + fileName.length() + 1);
+			filePath.append(folder);
 			CoTaskMemFree(path);
 
 			if (!subdirName.empty())
 			{
-				filePath.insert(filePath.length(), 1, BACKSLASH).append(subdirName);
+				filePath.append(1, L'\\').append(subdirName);
 			}
 
-			filePath.insert(filePath.length(), 1, BACKSLASH).append(fileName);
+			filePath.append(1, L'\\').append(fileName);
 		}
 
 		return filePath;
 	}
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring RenamePath(const std::wstring& fullPath, const std::wstring& newName)
-	{
-		auto pos{ fullPath.find_last_of(BACKSLASH) + 1 };
-		return fullPath.substr(0, pos).append(newName);
-	}
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      registry
@@ -899,233 +883,6 @@ namespace hlp
 		return std::wstring{};
 	}
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      string
-	//
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring EscapeBackslash(std::wstring str)
-	{
-		auto index{ str.length() };
-
-		while (--index != str.npos)
-		{
-			if (str[index] == BACKSLASH)
-			{
-				str.insert(index, 1, BACKSLASH);
-			}
-		}
-
-		return str;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring JoinStrings(const std::vector<std::wstring>& strings, const std::wstring& separator, size_t avgLength)
-	{
-		if (!strings.empty())
-		{
-			auto it{ strings.begin() };
-			auto end{ strings.end() };
-			auto buffer{ *it };
-
-			buffer.reserve(strings.size() * avgLength);
-
-			while (++it != end)
-			{
-				buffer.append(separator).append(*it);
-			}
-
-			return buffer;
-		}
-
-		return std::wstring{};
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	bool IsMultiSzItems(LPCSTR pMultiSz)
-	{
-		if (pMultiSz != nullptr)
-		{
-			pMultiSz += strlen(pMultiSz) + 1;
-
-			return *pMultiSz != 0;
-		}
-
-		return false;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	bool IsMultiSzItems(LPCWSTR pMultiSz)
-	{
-		if (pMultiSz != nullptr)
-		{
-			pMultiSz += wcslen(pMultiSz) + 1;
-
-			return *pMultiSz != 0;
-		}
-
-		return false;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	size_t GetMultiSzCount(LPCSTR pMultiSz)
-	{
-		size_t count{ 0 };
-
-		if (pMultiSz != nullptr)
-		{
-			while (*pMultiSz)
-			{
-				++count;
-				pMultiSz += strlen(pMultiSz) + 1;
-			}
-		}
-
-		return count;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	size_t GetMultiSzCount(LPCWSTR pMultiSz)
-	{
-		size_t count{ 0 };
-
-		if (pMultiSz != nullptr)
-		{
-			while (*pMultiSz)
-			{
-				++count;
-				pMultiSz += wcslen(pMultiSz) + 1;
-			}
-		}
-
-		return count;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	size_t GetMultiSzSize(LPCSTR pMultiSz)
-	{
-		if (pMultiSz != nullptr)
-		{
-			auto p{ pMultiSz };
-			while (*p)
-			{
-				p += strlen(p) + 1;
-			}
-
-			return ((p - pMultiSz) + 1) * sizeof(CHAR);
-		}
-
-		return 0;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	size_t GetMultiSzSize(LPCWSTR pMultiSz)
-	{
-		if (pMultiSz != nullptr)
-		{
-			auto p{ pMultiSz };
-			while (*p)
-			{
-				p += wcslen(p) + 1;
-			}
-
-			return ((p - pMultiSz) + 1) * sizeof(WCHAR);
-		}
-
-		return 0;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::vector<std::string> GetMultiSzItems(LPCSTR pMultiSz)
-	{
-		std::vector<std::string> items{};
-
-		if (pMultiSz != nullptr)
-		{
-			while (*pMultiSz)
-			{
-				items.push_back(std::string{ pMultiSz });
-				pMultiSz += strlen(pMultiSz) + 1;
-			}
-		}
-
-		return items;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz)
-	{
-		std::vector<std::wstring> items{};
-
-		if (pMultiSz != nullptr)
-		{
-			while (*pMultiSz)
-			{
-				auto length{ strlen(pMultiSz) };
-				items.push_back(std::wstring{ pMultiSz, pMultiSz + length });
-				pMultiSz += length + 1;
-			}
-		}
-
-		return items;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::vector<std::wstring> GetMultiSzItems(LPCWSTR pMultiSz)
-	{
-		std::vector<std::wstring> items{};
-
-		if (pMultiSz != nullptr)
-		{
-			while (*pMultiSz)
-			{
-				items.push_back(std::wstring{ pMultiSz });
-				pMultiSz += wcslen(pMultiSz) + 1;
-			}
-		}
-
-		return items;
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring TrimString(std::wstring str, WCHAR chr)
-	{
-		return str.erase(str.find_last_not_of(chr) + 1).erase(0, str.find_first_not_of(chr));
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring TrimStringBack(std::wstring str, WCHAR chr)
-	{
-		return str.erase(str.find_last_not_of(chr) + 1);
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring TrimStringFront(std::wstring str, WCHAR chr)
-	{
-		return str.erase(0, str.find_first_not_of(chr));
-	}
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	std::wstring WStrFromStr(LPCSTR pStr)
-	{
-		return std::wstring{ pStr, pStr + strlen(pStr) };
-	}
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      synchronization
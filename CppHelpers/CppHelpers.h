@@ -30,12 +30,9 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
-#include <chrono>
-#include <memory>
 #include <shlobj.h>
 #include <setupapi.h>
+#include "PortableHelpers.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -62,23 +59,18 @@ namespace hlp
 	// Returns : True if successful.
 	bool CopyToClipboard(HWND hWndNewOwner, const std::wstring& str);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      CodeTiming
-	//
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	// Simple class for code timing.
-	class CodeTiming
+	// Clipboard of the system, the data is written directly into the global memory block given to the clipboard.
+	class SystemClipboardBackend : public ClipboardBackend
 	{
 	public:
-		void Start() { start_ = std::chrono::steady_clock::now(); }
-		void Stop() { stop_ = std::chrono::steady_clock::now(); }
-		template <typename T>
-		std::wstring Result() const { return std::to_wstring(std::chrono::duration_cast<T>(stop_ - start_).count()); }
-	private:
-		std::chrono::time_point<std::chrono::steady_clock> start_;
-		std::chrono::time_point<std::chrono::steady_clock> stop_;
+		bool Open(HWND hWndNewOwner) override;
+		bool Empty() override;
+		bool SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer) override;
+		bool SetDelayedData(UINT uFormat) override;
+		void Close() override;
+		bool IsOwner(HWND hWnd) override;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,30 +85,22 @@ namespace hlp
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
-	// Class for reading a DROPFILES structure.
-	class DropFilesList
+	// Class for reading the DROPFILES structure of a data object, the medium is held until the list is unloaded.
+	class DataObjectDropFilesList : public DropFilesList
 	{
 	public:
-		DropFilesList();
-		~DropFilesList();
+		DataObjectDropFilesList();
+		~DataObjectDropFilesList() override;
+		using DropFilesList::Load;
 		// pDataObject : Pointer to a data object interface (IDataObject).
 		// Returns : True if the DROPFILES structure has been loaded successfully.
 		bool Load(LPDATAOBJECT pDataObject);
 		// Free the resources (doesn't need to be called before Load).
-		void Unload();
-		// Returns : True if the list has more than 1 item or false otherise (including no data loaded).
-		bool IsMultiItems() const;
-		// Returns : First item in the list or an empty string if there is no data loaded.
-		std::wstring GetFirstItem() const;
-		// Returns : All the items in the list or an empty container if there is no data loaded.
-		std::vector<std::wstring> GetItems() const;
-	protected:
-		// Pointer to a sequence of null-terminated strings, terminated by a null character "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-		LPCWSTR pList_;
-		// If fWide_ is not true, pList_ must be cast as LPCSTR to be usable.
-		bool fWide_;
+		void Unload() override;
 	private:
 		STGMEDIUM stgm_;
+		// True if stgm_ is locked and must be released.
+		bool fMedium_;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -144,7 +128,11 @@ namespace hlp
 		std::wstring GetDevicePath(LPCWSTR pDeviceName) const;
 		// Returns : All the device paths from the device information set or an empty container otherwise.
 		std::vector<std::wstring> GetDevicePaths() const;
+		// devicePaths : Storage to which all the device paths from the device information set are appended (nothing is appended otherwise).
+		void GetDevicePaths(StringArena& devicePaths) const;
 	private:
+		template <typename Callback>
+		bool EnumerateDevicePaths(Callback callback) const;
 		HDEVINFO hDevInfo_;
 		std::unique_ptr<GUID> classGuid_;
 		std::unique_ptr<WCHAR[]> enumerator_;
@@ -246,16 +234,6 @@ namespace hlp
 		void CreateVolDiskExtBuffer(DWORD size);
 	};
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      environment
-	//
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// argument : Argument to be escaped.
-	// Returns : String containing the escaped argument.
-	std::wstring EscapeArgument(std::wstring argument);
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      image
@@ -311,13 +289,6 @@ namespace hlp
 	// Returns : File path if successful or an empty string otherwise.
 	std::wstring GetFilePath(const KNOWNFOLDERID& knownFolder, const std::wstring& subdirName, const std::wstring& fileName);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// fullPath : Full path of a file or directory.
-	// newName : New name of the last path item (after the last backslash).
-	// Returns : String containing the renamed path (doesn't rename the actual item on disk if it exists).
-	std::wstring RenamePath(const std::wstring& fullPath, const std::wstring& newName);
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      registry
@@ -367,105 +338,6 @@ namespace hlp
 	// Returns : String if successful or an empty string otherwise.
 	std::wstring LoadStringResource(HMODULE hModule, WORD idString);
 
-	///////////////////////////////////////////////////////////////////////////////////////////////
-	//
-	//                                      string
-	//
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// str : String to be processed.
-	// Returns : String where all the backslashes are escaped (doubled).
-	std::wstring EscapeBackslash(std::wstring str);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// strings : Strings to be joined.
-	// separator : String used as separator.
-	// avgLength : Approximation of the average length of a string in the container (optimization purpose).
-	// Returns : String made of all the strings joined together and separated by the specified separator.
-	std::wstring JoinStrings(const std::vector<std::wstring>& strings, const std::wstring& separator, size_t avgLength);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : True if the sequence has more than one item.
-	bool IsMultiSzItems(LPCSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : True if the sequence has more than one item.
-	bool IsMultiSzItems(LPCWSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : Count of null-terminated strings in the sequence.
-	size_t GetMultiSzCount(LPCSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : Count of null-terminated strings in the sequence.
-	size_t GetMultiSzCount(LPCWSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : Size in bytes of the sequence including the null terminator or 0 if str is null.
-	size_t GetMultiSzSize(LPCSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : Size in bytes of the sequence including the null terminator or 0 if str is null.
-	size_t GetMultiSzSize(LPCWSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
-	std::vector<std::string> GetMultiSzItems(LPCSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : All the items in the sequence (converted to wide character string) or an empty container if str is null or points to a null terminator.
-	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
-	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
-	std::vector<std::wstring> GetMultiSzItems(LPCWSTR pMultiSz);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// str : String to be trimmed.
-	// chr : Leading and trailing characters to be removed.
-	// Returns : Trimmed string.
-	std::wstring TrimString(std::wstring str, WCHAR chr);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// str : String to be trimmed.
-	// chr : Trailing characters to be removed.
-	// Returns : Trimmed string.
-	std::wstring TrimStringBack(std::wstring str, WCHAR chr);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// str : String to be trimmed.
-	// chr : Leading characters to be removed.
-	// Returns : Trimmed string.
-	std::wstring TrimStringFront(std::wstring str, WCHAR chr);
-
-	///////////////////////////////////////////////////////////////////////////////////////////////
-
-	// pStr : String to be processed.
-	// Returns : Wide character string.
-	std::wstring WStrFromStr(LPCSTR pStr);
-
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	//
 	//                                      synchronization
@@ -0,0 +1,3836 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+// CppHelpers 1.5
+// Windows 7 and above
+//
+// MIT License
+//
+// Copyright(c) 2019 Philippe Coulombe
+// https://github.com/ebmoluoc/CppHelpers
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#define NTDDI_VERSION	0x06010000
+#define WINVER			0x0601
+#define _WIN32_WINDOWS	0x0601
+#define _WIN32_WINNT	0x0601
+#define _WIN32_IE		0x0A00
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <unordered_map>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include "PortableHelpers.h"
+
+#ifndef _MSC_VER
+#include <cpuid.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const WCHAR BACKSLASH{ '\\' };
+static const WCHAR QUOTE{ '\"' };
+static const WCHAR SLASH{ '/' };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Functions using AVX2 instructions, they are called only if the processor supports them.
+// Kernels shared by the SSE2 and AVX2 paths are forced inline, so they are compiled for AVX2 in the AVX2 functions.
+#ifdef _MSC_VER
+#define HLP_AVX2
+#define HLP_FORCEINLINE __forceinline
+#else
+#define HLP_AVX2 __attribute__((target("avx2")))
+#define HLP_FORCEINLINE inline __attribute__((always_inline))
+#endif
+
+// Loads of aligned blocks that may extend past the end of a string (never past its page), hidden from AddressSanitizer.
+#ifdef _MSC_VER
+#define HLP_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define HLP_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+
+// leaf : Function of the CPUID instruction.
+// subleaf : Subfunction of the CPUID instruction.
+// info : Receives EAX, EBX, ECX and EDX.
+static void CpuId(int leaf, int subleaf, int(&info)[4])
+{
+#ifdef _MSC_VER
+	__cpuidex(info, leaf, subleaf);
+#else
+	__cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+}
+
+// Returns : Features enabled by the OS in the XCR0 register (OSXSAVE must be supported).
+static unsigned long long GetEnabledXFeatures()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int low;
+	unsigned int high;
+	__asm__ volatile ("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return (static_cast<unsigned long long>(high) << 32) | low;
+#endif
+}
+
+// mask : Mask with at least one bit set.
+// Returns : Index of the lowest bit set.
+static unsigned long GetLowestBit(unsigned long long mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return index;
+#else
+	return static_cast<unsigned long>(__builtin_ctzll(mask));
+#endif
+}
+
+// mask : Mask with at least one bit set.
+// Returns : Index of the highest bit set.
+static unsigned long GetHighestBit(unsigned long long mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, mask);
+	return index;
+#else
+	return static_cast<unsigned long>(63 - __builtin_clzll(mask));
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace hlp
+{
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      clipboard
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	MemoryClipboardBackend::MemoryClipboardBackend() :
+		formats_{}, delayedFormats_{}, renderRequests_{}, messageHandler_{}, hWndOpen_{ nullptr }, hWndOwner_{ nullptr }, openCount_{ 0 }, open_{ false }, owned_{ false }, rendering_{ false }
+	{
+	}
+
+	bool MemoryClipboardBackend::Open(HWND hWndNewOwner)
+	{
+		if (open_)
+		{
+			return false;
+		}
+
+		open_ = true;
+		hWndOpen_ = hWndNewOwner;
+		++openCount_;
+
+		return true;
+	}
+
+	bool MemoryClipboardBackend::Empty()
+	{
+		if (!open_)
+		{
+			return false;
+		}
+
+		// The previous owner is told that its data is being replaced, as EmptyClipboard does.
+		if (owned_ && messageHandler_)
+		{
+			messageHandler_(hWndOwner_, WM_DESTROYCLIPBOARD, 0);
+		}
+
+		formats_.clear();
+		delayedFormats_.clear();
+		hWndOwner_ = hWndOpen_;
+		owned_ = true;
+
+		return true;
+	}
+
+	bool MemoryClipboardBackend::SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer)
+	{
+		if (!open_ && !rendering_)
+		{
+			return false;
+		}
+
+		std::vector<BYTE> data(nBytes);
+		if (!writer(data.data(), nBytes))
+		{
+			return false;
+		}
+
+		auto it{ std::find_if(formats_.begin(), formats_.end(), [uFormat](const auto& format) { return format.first == uFormat; }) };
+		if (it != formats_.end())
+		{
+			it->second = std::move(data);
+		}
+		else
+		{
+			formats_.emplace_back(uFormat, std::move(data));
+		}
+
+		delayedFormats_.erase(std::remove(delayedFormats_.begin(), delayedFormats_.end(), uFormat), delayedFormats_.end());
+
+		return true;
+	}
+
+	bool MemoryClipboardBackend::SetDelayedData(UINT uFormat)
+	{
+		if (!open_)
+		{
+			return false;
+		}
+
+		if (std::find(delayedFormats_.begin(), delayedFormats_.end(), uFormat) == delayedFormats_.end())
+		{
+			delayedFormats_.push_back(uFormat);
+		}
+
+		return true;
+	}
+
+	void MemoryClipboardBackend::Close()
+	{
+		open_ = false;
+	}
+
+	bool MemoryClipboardBackend::IsOwner(HWND hWnd)
+	{
+		return hWndOwner_ == hWnd;
+	}
+
+	void MemoryClipboardBackend::SetMessageHandler(std::function<void(HWND, UINT, WPARAM)> handler)
+	{
+		messageHandler_ = std::move(handler);
+	}
+
+	const std::vector<BYTE>* MemoryClipboardBackend::RequestData(UINT uFormat)
+	{
+		if (std::find(delayedFormats_.begin(), delayedFormats_.end(), uFormat) != delayedFormats_.end())
+		{
+			renderRequests_.push_back(uFormat);
+
+			if (messageHandler_)
+			{
+				rendering_ = true;
+				messageHandler_(hWndOwner_, WM_RENDERFORMAT, uFormat);
+				rendering_ = false;
+			}
+		}
+
+		return GetData(uFormat);
+	}
+
+	const std::vector<UINT>& MemoryClipboardBackend::GetRenderRequests() const
+	{
+		return renderRequests_;
+	}
+
+	bool MemoryClipboardBackend::IsOpen() const
+	{
+		return open_;
+	}
+
+	size_t MemoryClipboardBackend::GetOpenCount() const
+	{
+		return openCount_;
+	}
+
+	size_t MemoryClipboardBackend::GetFormatCount() const
+	{
+		return formats_.size() + delayedFormats_.size();
+	}
+
+	const std::vector<BYTE>* MemoryClipboardBackend::GetData(UINT uFormat) const
+	{
+		auto it{ std::find_if(formats_.begin(), formats_.end(), [uFormat](const auto& format) { return format.first == uFormat; }) };
+
+		return it != formats_.end() ? &it->second : nullptr;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ClipboardTransaction::ClipboardTransaction(ClipboardBackend& backend) : backend_{ backend }, open_{ false }
+	{
+	}
+
+	ClipboardTransaction::~ClipboardTransaction()
+	{
+		Close();
+	}
+
+	bool ClipboardTransaction::Open(HWND hWndNewOwner)
+	{
+		if (open_ || !backend_.Open(hWndNewOwner))
+		{
+			return false;
+		}
+
+		open_ = true;
+
+		if (!backend_.Empty())
+		{
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ClipboardTransaction::SetData(UINT uFormat, LPCVOID pData, SIZE_T nBytes)
+	{
+		return SetData(uFormat, nBytes, [pData](LPVOID pMem, SIZE_T nMemBytes)
+		{
+			memcpy(pMem, pData, nMemBytes);
+			return true;
+		});
+	}
+
+	bool ClipboardTransaction::SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer)
+	{
+		return open_ && backend_.SetData(uFormat, nBytes, writer);
+	}
+
+	bool ClipboardTransaction::SetText(std::wstring_view str)
+	{
+		auto nBytes{ (str.length() + 1) * sizeof(WCHAR) };
+
+		return SetData(CF_UNICODETEXT, nBytes, [str](LPVOID pMem, SIZE_T)
+		{
+			auto pText{ static_cast<LPWSTR>(pMem) };
+			str.copy(pText, str.length());
+			pText[str.length()] = '\0';
+			return true;
+		});
+	}
+
+	bool ClipboardTransaction::SetDelayedData(UINT uFormat)
+	{
+		return open_ && backend_.SetDelayedData(uFormat);
+	}
+
+	void ClipboardTransaction::Close()
+	{
+		if (open_)
+		{
+			backend_.Close();
+			open_ = false;
+		}
+	}
+
+	bool ClipboardTransaction::IsOpen() const
+	{
+		return open_;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	DelayedClipboardProvider::DelayedClipboardProvider(ClipboardBackend& backend) : backend_{ backend }, formats_{}, publishing_{ false }
+	{
+	}
+
+	void DelayedClipboardProvider::AddFormat(UINT uFormat, ClipboardProducer producer)
+	{
+		auto it{ std::find_if(formats_.begin(), formats_.end(), [uFormat](const Format& format) { return format.format == uFormat; }) };
+		if (it != formats_.end())
+		{
+			*it = Format{ uFormat, std::move(producer), std::nullopt, false };
+		}
+		else
+		{
+			formats_.push_back(Format{ uFormat, std::move(producer), std::nullopt, false });
+		}
+	}
+
+	bool DelayedClipboardProvider::Publish(HWND hWndOwner)
+	{
+		// The data rendered for a previous publication is no longer valid.
+		Clear();
+
+		// Emptying the clipboard sends WM_DESTROYCLIPBOARD to the window if it was already the owner,
+		// the message is then about the previous publication and must be ignored.
+		publishing_ = true;
+		ClipboardTransaction transaction{ backend_ };
+		auto opened{ transaction.Open(hWndOwner) };
+		publishing_ = false;
+
+		if (!opened)
+		{
+			return false;
+		}
+
+		for (const auto& format : formats_)
+		{
+			if (!transaction.SetDelayedData(format.format))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool DelayedClipboardProvider::RenderFormat(UINT uFormat)
+	{
+		auto it{ std::find_if(formats_.begin(), formats_.end(), [uFormat](const Format& format) { return format.format == uFormat; }) };
+		if (it == formats_.end() || !it->producer)
+		{
+			return false;
+		}
+
+		if (!it->data.has_value())
+		{
+			it->data = it->producer();
+		}
+
+		const auto& data{ *it->data };
+
+		it->rendered = backend_.SetData(uFormat, data.size(), [&data](LPVOID pMem, SIZE_T nBytes)
+		{
+			memcpy(pMem, data.data(), nBytes);
+			return true;
+		});
+
+		return it->rendered;
+	}
+
+	bool DelayedClipboardProvider::RenderAllFormats(HWND hWndOwner)
+	{
+		if (!backend_.Open(hWndOwner))
+		{
+			return false;
+		}
+
+		auto succeeded{ true };
+
+		// Another application may have emptied the clipboard before it has been opened.
+		if (backend_.IsOwner(hWndOwner))
+		{
+			for (const auto& format : formats_)
+			{
+				if (!format.rendered && !RenderFormat(format.format))
+				{
+					succeeded = false;
+				}
+			}
+		}
+
+		backend_.Close();
+
+		return succeeded;
+	}
+
+	void DelayedClipboardProvider::Clear()
+	{
+		for (auto& format : formats_)
+		{
+			format.data.reset();
+			format.rendered = false;
+		}
+	}
+
+	bool DelayedClipboardProvider::HandleMessage(HWND hWnd, UINT uMsg, WPARAM wParam)
+	{
+		switch (uMsg)
+		{
+		case WM_RENDERFORMAT:
+			RenderFormat(static_cast<UINT>(wParam));
+			return true;
+		case WM_RENDERALLFORMATS:
+			RenderAllFormats(hWnd);
+			return true;
+		case WM_DESTROYCLIPBOARD:
+			if (!publishing_)
+			{
+				Clear();
+			}
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	size_t DelayedClipboardProvider::GetCacheSize() const
+	{
+		size_t size{ 0 };
+
+		for (const auto& format : formats_)
+		{
+			if (format.data.has_value())
+			{
+				size += format.data->size();
+			}
+		}
+
+		return size;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      CodeTiming
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HLP_TSC
+	// Returns : True if the processor reports an invariant time stamp counter.
+	static bool IsInvariantTscSupported()
+	{
+		int info[4];
+
+		CpuId(static_cast<int>(0x80000000), 0, info);
+		if (static_cast<unsigned int>(info[0]) < 0x80000007)
+		{
+			return false;
+		}
+
+		CpuId(static_cast<int>(0x80000007), 0, info);
+		return (info[3] & (1 << 8)) != 0;
+	}
+#endif
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	TscCalibration CalibrateTsc()
+	{
+		TscCalibration calibration{ false, 0.0, 0 };
+
+#ifdef HLP_TSC
+		calibration.invariant = IsInvariantTscSupported();
+
+		if (calibration.invariant)
+		{
+			auto start{ std::chrono::steady_clock::now() };
+			auto startTicks{ __rdtsc() };
+			auto stop{ start };
+
+			while (stop - start < std::chrono::milliseconds{ 10 })
+			{
+				stop = std::chrono::steady_clock::now();
+			}
+
+			auto ticks{ __rdtsc() - startTicks };
+			calibration.baseTicks = startTicks;
+			auto nanoseconds{ std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() };
+
+			if (ticks != 0)
+			{
+				calibration.nanosecondsPerTick = static_cast<double>(nanoseconds) / static_cast<double>(ticks);
+			}
+			else
+			{
+				calibration.invariant = false;
+			}
+		}
+#endif
+
+		return calibration;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The values below 2^SUB_BUCKET_BITS have their own bucket, the others are grouped in buckets of 2^(msb - 6) values.
+	static const unsigned long PROFILER_SUB_BUCKET_BITS{ 7 };
+	static const unsigned long PROFILER_MAX_BITS{ 40 };
+	static const size_t PROFILER_HALF_SUB_BUCKETS{ size_t{ 1 } << (PROFILER_SUB_BUCKET_BITS - 1) };
+	static const size_t PROFILER_BUCKET_COUNT{ (PROFILER_MAX_BITS - PROFILER_SUB_BUCKET_BITS + 2) * PROFILER_HALF_SUB_BUCKETS };
+
+	// Buckets written by a single thread and read by GetProfilerStats.
+	struct ProfilerHistogram
+	{
+		std::atomic<UINT64> counts[PROFILER_BUCKET_COUNT];
+		std::atomic<UINT64> sum;
+	};
+
+	struct ProfilerThreadData
+	{
+		std::atomic<ProfilerHistogram*> histograms[MAX_PROFILER_PROBES];
+	};
+
+	// The histograms of the threads that have exited are merged into a retired histogram per probe,
+	// so their durations are still reported without keeping their data.
+	struct ProfilerRegistry
+	{
+		std::mutex mutex;
+		std::vector<LPCWSTR> names;
+		std::vector<std::unique_ptr<ProfilerThreadData>> threads;
+		std::vector<std::unique_ptr<ProfilerHistogram>> histograms;
+		std::unique_ptr<ProfilerHistogram> retired[MAX_PROFILER_PROBES];
+	};
+
+	static ProfilerRegistry& GetProfilerRegistry()
+	{
+		// Never destroyed, the threads still running at exit (like the workers of a static pool) retire their data in it.
+		static auto& registry{ *new ProfilerRegistry{} };
+		return registry;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// data : Data of the exiting thread, merged into the retired histograms and released.
+	static void RetireProfilerThreadData(ProfilerThreadData& data)
+	{
+		auto& registry{ GetProfilerRegistry() };
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		for (size_t id{ 0 }; id < MAX_PROFILER_PROBES; ++id)
+		{
+			auto pHistogram{ data.histograms[id].load(std::memory_order_relaxed) };
+			if (pHistogram == nullptr)
+			{
+				continue;
+			}
+
+			auto& pRetired{ registry.retired[id] };
+			if (!pRetired)
+			{
+				pRetired = std::make_unique<ProfilerHistogram>();
+			}
+
+			for (size_t bucket{ 0 }; bucket < PROFILER_BUCKET_COUNT; ++bucket)
+			{
+				auto& count{ pRetired->counts[bucket] };
+				count.store(count.load(std::memory_order_relaxed) + pHistogram->counts[bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+
+			pRetired->sum.store(pRetired->sum.load(std::memory_order_relaxed) + pHistogram->sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			registry.histograms.erase(std::find_if(registry.histograms.begin(), registry.histograms.end(),
+				[pHistogram](const auto& pOwned) { return pOwned.get() == pHistogram; }));
+		}
+
+		registry.threads.erase(std::find_if(registry.threads.begin(), registry.threads.end(),
+			[&data](const auto& pThread) { return pThread.get() == &data; }));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Data of the calling thread, retired when the thread exits.
+	class ProfilerThreadOwner
+	{
+	public:
+		ProfilerThreadOwner() : pData_{ nullptr } {}
+
+		~ProfilerThreadOwner()
+		{
+			if (pData_ != nullptr)
+			{
+				RetireProfilerThreadData(*pData_);
+			}
+		}
+
+		ProfilerThreadData& Get()
+		{
+			if (pData_ == nullptr)
+			{
+				auto& registry{ GetProfilerRegistry() };
+				std::lock_guard<std::mutex> lock{ registry.mutex };
+				registry.threads.push_back(std::make_unique<ProfilerThreadData>());
+				pData_ = registry.threads.back().get();
+			}
+
+			return *pData_;
+		}
+	private:
+		ProfilerThreadData* pData_;
+	};
+
+	static ProfilerThreadData& GetProfilerThreadData()
+	{
+		thread_local ProfilerThreadOwner owner{};
+		return owner.Get();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// value : Duration in nanoseconds.
+	// Returns : Index of the bucket of the value.
+	static size_t GetProfilerBucket(UINT64 value)
+	{
+		value = (std::min)(value, (UINT64{ 1 } << PROFILER_MAX_BITS) - 1);
+
+		if (value < (UINT64{ 1 } << PROFILER_SUB_BUCKET_BITS))
+		{
+			return static_cast<size_t>(value);
+		}
+
+		auto shift{ GetHighestBit(value) - (PROFILER_SUB_BUCKET_BITS - 1) };
+
+		return shift * PROFILER_HALF_SUB_BUCKETS + static_cast<size_t>(value >> shift);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// bucket : Index of a bucket.
+	// Returns : Highest value of the bucket.
+	static UINT64 GetProfilerBucketValue(size_t bucket)
+	{
+		if (bucket < (size_t{ 1 } << PROFILER_SUB_BUCKET_BITS))
+		{
+			return bucket;
+		}
+
+		auto shift{ bucket / PROFILER_HALF_SUB_BUCKETS - 1 };
+		auto subBucket{ static_cast<UINT64>(bucket - shift * PROFILER_HALF_SUB_BUCKETS) };
+
+		return ((subBucket + 1) << shift) - 1;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	ProfilerProbe::ProfilerProbe(LPCWSTR pName) : pName_{ pName }, id_{ MAX_PROFILER_PROBES }
+	{
+		auto& registry{ GetProfilerRegistry() };
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		if (registry.names.size() < MAX_PROFILER_PROBES)
+		{
+			id_ = registry.names.size();
+			registry.names.push_back(pName);
+		}
+	}
+
+	void ProfilerProbe::Record(std::chrono::nanoseconds duration) const
+	{
+		if (id_ >= MAX_PROFILER_PROBES)
+		{
+			return;
+		}
+
+		auto& histogram{ GetProfilerThreadData().histograms[id_] };
+		auto pHistogram{ histogram.load(std::memory_order_acquire) };
+
+		if (pHistogram == nullptr)
+		{
+			auto& registry{ GetProfilerRegistry() };
+			std::lock_guard<std::mutex> lock{ registry.mutex };
+			registry.histograms.push_back(std::make_unique<ProfilerHistogram>());
+			pHistogram = registry.histograms.back().get();
+			histogram.store(pHistogram, std::memory_order_release);
+		}
+
+		auto value{ static_cast<UINT64>((std::max)(duration.count(), decltype(duration.count()){ 0 })) };
+
+		// Only the owning thread writes the buckets, so a plain load and store is enough (no locked instruction).
+		auto& count{ pHistogram->counts[GetProfilerBucket(value)] };
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		pHistogram->sum.store(pHistogram->sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	LPCWSTR ProfilerProbe::GetName() const
+	{
+		return pName_;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<ProfilerStats> GetProfilerStats()
+	{
+		std::vector<ProfilerStats> stats{};
+		std::vector<UINT64> counts(PROFILER_BUCKET_COUNT);
+
+		auto& registry{ GetProfilerRegistry() };
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		for (size_t id{ 0 }; id < registry.names.size(); ++id)
+		{
+			std::fill(counts.begin(), counts.end(), 0);
+			UINT64 total{ 0 };
+			UINT64 sum{ 0 };
+
+			auto add{ [&](const ProfilerHistogram* pHistogram)
+			{
+				if (pHistogram != nullptr)
+				{
+					for (size_t bucket{ 0 }; bucket < PROFILER_BUCKET_COUNT; ++bucket)
+					{
+						auto count{ pHistogram->counts[bucket].load(std::memory_order_relaxed) };
+						counts[bucket] += count;
+						total += count;
+					}
+
+					sum += pHistogram->sum.load(std::memory_order_relaxed);
+				}
+			} };
+
+			add(registry.retired[id].get());
+
+			for (const auto& pThread : registry.threads)
+			{
+				add(pThread->histograms[id].load(std::memory_order_acquire));
+			}
+
+			if (total == 0)
+			{
+				continue;
+			}
+
+			// Value of the first bucket reaching the rank of each percentile.
+			const double percentiles[]{ 0.5, 0.99, 0.999 };
+			UINT64 values[3]{};
+			size_t percentile{ 0 };
+			UINT64 cumulative{ 0 };
+			UINT64 max{ 0 };
+
+			for (size_t bucket{ 0 }; bucket < PROFILER_BUCKET_COUNT; ++bucket)
+			{
+				if (counts[bucket] != 0)
+				{
+					cumulative += counts[bucket];
+					max = GetProfilerBucketValue(bucket);
+
+					while (percentile < 3 && cumulative >= (std::max)(static_cast<UINT64>(percentiles[percentile] * total + 0.5), UINT64{ 1 }))
+					{
+						values[percentile++] = max;
+					}
+				}
+			}
+
+			stats.push_back(ProfilerStats{ registry.names[id], total, sum / total, values[0], values[1], values[2], max });
+		}
+
+		return stats;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring GetProfilerReport()
+	{
+		std::wstring report{};
+
+		for (const auto& stats : GetProfilerStats())
+		{
+			report += stats.pName;
+			report += L" : count=" + std::to_wstring(stats.count);
+			report += L" mean=" + std::to_wstring(stats.mean);
+			report += L"ns p50=" + std::to_wstring(stats.p50);
+			report += L"ns p99=" + std::to_wstring(stats.p99);
+			report += L"ns p999=" + std::to_wstring(stats.p999);
+			report += L"ns max=" + std::to_wstring(stats.max);
+			report += L"ns\r\n";
+		}
+
+		return report;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ResetProfiler()
+	{
+		auto& registry{ GetProfilerRegistry() };
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+
+		for (const auto& pHistogram : registry.histograms)
+		{
+			for (auto& count : pHistogram->counts)
+			{
+				count.store(0, std::memory_order_relaxed);
+			}
+
+			pHistogram->sum.store(0, std::memory_order_relaxed);
+		}
+
+		for (auto& pRetired : registry.retired)
+		{
+			pRetired.reset();
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      com
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Defined in the string section.
+	static size_t ConvertToWide(std::string_view str, UINT codePage, LPWSTR pBuffer);
+
+	// pList : Sequence of null-terminated strings.
+	// length : Length of the sequence in characters.
+	// Returns : True if the sequence is terminated (by an empty string) within its length.
+	template <typename T>
+	static bool IsMultiSzTerminated(const T* pList, size_t length)
+	{
+		if (length == 0)
+		{
+			return false;
+		}
+
+		if (pList[0] == 0)
+		{
+			return true;
+		}
+
+		for (size_t i{ 1 }; i < length; ++i)
+		{
+			if (pList[i] == 0 && pList[i - 1] == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	DropFilesList::DropFilesList() : pList_{ nullptr }, fWide_{ false }
+	{
+	}
+
+	DropFilesList::~DropFilesList()
+	{
+		Unload();
+	}
+
+	bool DropFilesList::Load(LPCVOID pData, SIZE_T nBytes)
+	{
+		TraceScope trace{ L"DropFilesList::Load" };
+
+		Unload();
+
+		return Attach(pData, nBytes);
+	}
+
+	void DropFilesList::Unload()
+	{
+		pList_ = nullptr;
+		wideIndex_.Load(nullptr);
+		narrowIndex_.Load(nullptr);
+	}
+
+	bool DropFilesList::IsMultiItems() const
+	{
+		if (wideIndex_.data() != nullptr || narrowIndex_.data() != nullptr)
+		{
+			return wideIndex_.IsMultiItems() || narrowIndex_.IsMultiItems();
+		}
+
+		if (fWide_)
+		{
+			return IsMultiSzItems(pList_);
+		}
+
+		return IsMultiSzItems(reinterpret_cast<LPCSTR>(pList_));
+	}
+
+	std::wstring DropFilesList::GetFirstItem() const
+	{
+		if (pList_ == nullptr)
+		{
+			return std::wstring{};
+		}
+
+		if (fWide_)
+		{
+			return std::wstring{ pList_ };
+		}
+
+		return WStrFromStr(reinterpret_cast<LPCSTR>(pList_), CP_ACP);
+	}
+
+	std::vector<std::wstring> DropFilesList::GetItems() const
+	{
+		if (fWide_)
+		{
+			return GetMultiSzItems(pList_);
+		}
+
+		return GetMultiSzItemsWide(reinterpret_cast<LPCSTR>(pList_), CP_ACP);
+	}
+
+	void DropFilesList::GetItems(StringArena& items) const
+	{
+		if (fWide_)
+		{
+			GetMultiSzItems(pList_, items);
+		}
+		else
+		{
+			GetMultiSzItemsWide(reinterpret_cast<LPCSTR>(pList_), CP_ACP, items);
+		}
+	}
+
+	size_t DropFilesList::Count() const
+	{
+		BuildIndex();
+
+		return fWide_ ? wideIndex_.size() : narrowIndex_.size();
+	}
+
+	std::wstring DropFilesList::GetItem(size_t index) const
+	{
+		BuildIndex();
+
+		if (fWide_)
+		{
+			return std::wstring{ wideIndex_[index] };
+		}
+
+		std::wstring item{};
+		ConvertItem(narrowIndex_[index], item);
+
+		return item;
+	}
+
+	// https://docs.microsoft.com/en-us/windows/win32/api/shlobj_core/ns-shlobj_core-dropfiles
+	bool DropFilesList::Attach(LPCVOID pData, SIZE_T nBytes)
+	{
+		auto pDropFiles{ static_cast<const DROPFILES*>(pData) };
+		if (pDropFiles == nullptr || nBytes < sizeof(DROPFILES) || pDropFiles->pFiles < sizeof(DROPFILES) || pDropFiles->pFiles >= nBytes)
+		{
+			return false;
+		}
+
+		auto pList{ static_cast<const BYTE*>(pData) + pDropFiles->pFiles };
+		auto listBytes{ nBytes - pDropFiles->pFiles };
+
+		auto terminated{ pDropFiles->fWide ?
+			IsMultiSzTerminated(reinterpret_cast<LPCWSTR>(pList), listBytes / sizeof(WCHAR)) :
+			IsMultiSzTerminated(reinterpret_cast<LPCSTR>(pList), listBytes) };
+
+		if (terminated)
+		{
+			pList_ = reinterpret_cast<LPCWSTR>(pList);
+			fWide_ = pDropFiles->fWide != FALSE;
+		}
+
+		return terminated;
+	}
+
+	void DropFilesList::BuildIndex() const
+	{
+		if (fWide_ && wideIndex_.data() == nullptr)
+		{
+			wideIndex_.Load(pList_);
+		}
+		else if (!fWide_ && narrowIndex_.data() == nullptr)
+		{
+			narrowIndex_.Load(reinterpret_cast<LPCSTR>(pList_));
+		}
+	}
+
+	void DropFilesList::ConvertItem(std::string_view item, std::wstring& buffer)
+	{
+		buffer.resize(item.length());
+		buffer.resize(ConvertToWide(item, CP_ACP, &buffer[0]));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      environment
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// argument : Argument to be processed.
+	// Returns : True if the argument must be enclosed in quotes.
+	static bool IsQuotingNeeded(std::wstring_view argument)
+	{
+		return argument.empty() || argument.find_first_of(L" \"\t") != argument.npos;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetEscapedArgumentLength(std::wstring_view argument)
+	{
+		if (!IsQuotingNeeded(argument))
+		{
+			return argument.length();
+		}
+
+		auto length{ argument.length() + 2 };
+		size_t backslashes{ 0 };
+
+		for (auto chr : argument)
+		{
+			if (chr == BACKSLASH)
+			{
+				++backslashes;
+			}
+			else
+			{
+				if (chr == QUOTE)
+				{
+					length += backslashes + 1;
+				}
+
+				backslashes = 0;
+			}
+		}
+
+		// The backslashes before the closing quote are doubled.
+		return length + backslashes;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// https://docs.microsoft.com/en-us/cpp/cpp/parsing-cpp-command-line-arguments
+	LPWSTR EscapeArgument(std::wstring_view argument, LPWSTR pBuffer)
+	{
+		if (!IsQuotingNeeded(argument))
+		{
+			return pBuffer + argument.copy(pBuffer, argument.length());
+		}
+
+		size_t backslashes{ 0 };
+
+		*pBuffer++ = QUOTE;
+
+		for (auto chr : argument)
+		{
+			if (chr == BACKSLASH)
+			{
+				++backslashes;
+			}
+			else
+			{
+				if (chr == QUOTE)
+				{
+					pBuffer = std::fill_n(pBuffer, backslashes + 1, BACKSLASH);
+				}
+
+				backslashes = 0;
+			}
+
+			*pBuffer++ = chr;
+		}
+
+		pBuffer = std::fill_n(pBuffer, backslashes, BACKSLASH);
+		*pBuffer++ = QUOTE;
+
+		return pBuffer;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring EscapeArgument(std::wstring argument)
+	{
+		if (!IsQuotingNeeded(argument))
+		{
+			return argument;
+		}
+
+		std::wstring escaped(GetEscapedArgumentLength(argument), L'\0');
+		EscapeArgument(argument, &escaped[0]);
+
+		return escaped;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	CommandLineArguments::CommandLineArguments() : bufferLength_{ 0 }
+	{
+	}
+
+	// https://docs.microsoft.com/en-us/cpp/cpp/parsing-cpp-command-line-arguments
+	void CommandLineArguments::Load(std::wstring_view commandLine)
+	{
+		arguments_.clear();
+
+		auto isBlank{ [](WCHAR chr) { return chr == L' ' || chr == L'\t'; } };
+		auto length{ commandLine.length() };
+		LPWSTR pUnescaped{ nullptr };
+		size_t index{ 0 };
+
+		for (;;)
+		{
+			while (index < length && isBlank(commandLine[index]))
+			{
+				++index;
+			}
+
+			if (index == length)
+			{
+				break;
+			}
+
+			auto start{ index };
+			while (index < length && !isBlank(commandLine[index]) && commandLine[index] != QUOTE)
+			{
+				++index;
+			}
+
+			// Without quotes, backslashes are literal and the argument is used as is.
+			if (index == length || commandLine[index] != QUOTE)
+			{
+				arguments_.push_back(commandLine.substr(start, index - start));
+				continue;
+			}
+
+			// An unescaped argument is never longer than its source, so the buffer never needs to grow.
+			if (pUnescaped == nullptr)
+			{
+				if (bufferLength_ < length)
+				{
+					buffer_.reset(new WCHAR[length]);
+					bufferLength_ = length;
+				}
+
+				pUnescaped = buffer_.get();
+			}
+
+			auto pArgument{ pUnescaped };
+			auto quoted{ false };
+			index = start;
+
+			while (index < length && (quoted || !isBlank(commandLine[index])))
+			{
+				auto chr{ commandLine[index] };
+
+				if (chr == BACKSLASH)
+				{
+					auto first{ index };
+					while (index < length && commandLine[index] == BACKSLASH)
+					{
+						++index;
+					}
+
+					auto backslashes{ index - first };
+					if (index < length && commandLine[index] == QUOTE)
+					{
+						// 2n backslashes + quote : n backslashes and a delimiting quote.
+						// 2n+1 backslashes + quote : n backslashes and a literal quote.
+						pUnescaped = std::fill_n(pUnescaped, backslashes / 2, BACKSLASH);
+						if (backslashes % 2 != 0)
+						{
+							*pUnescaped++ = QUOTE;
+							++index;
+						}
+					}
+					else
+					{
+						pUnescaped = std::fill_n(pUnescaped, backslashes, BACKSLASH);
+					}
+				}
+				else if (chr == QUOTE)
+				{
+					// Two quotes in a quoted block : literal quote and the block goes on.
+					if (quoted && index + 1 < length && commandLine[index + 1] == QUOTE)
+					{
+						*pUnescaped++ = QUOTE;
+						index += 2;
+					}
+					else
+					{
+						quoted = !quoted;
+						++index;
+					}
+				}
+				else
+				{
+					*pUnescaped++ = chr;
+					++index;
+				}
+			}
+
+			arguments_.push_back(std::wstring_view{ pArgument, static_cast<size_t>(pUnescaped - pArgument) });
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      path
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// chr : Character to be checked.
+	// Returns : True if the character is a drive letter (A to Z).
+	static bool IsDriveLetter(WCHAR chr)
+	{
+		return (chr | 0x20) >= L'a' && (chr | 0x20) <= L'z';
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// chr : Character to be checked.
+	// slash : True if a slash is also a separator.
+	// Returns : True if the character is a path separator.
+	static bool IsPathSeparator(WCHAR chr, bool slash)
+	{
+		return chr == BACKSLASH || (slash && chr == SLASH);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// path : Path to be parsed.
+	// pos : Position of a path component.
+	// slash : True if a slash is also a separator.
+	// Returns : Position after the component and the separator following it if any.
+	static size_t SkipPathComponent(std::wstring_view path, size_t pos, bool slash)
+	{
+		while (pos < path.length() && !IsPathSeparator(path[pos], slash))
+		{
+			++pos;
+		}
+
+		return (std::min)(pos + 1, path.length());
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// path : Path to be checked.
+	// pos : Position of the prefix.
+	// Returns : True if "UNC" (case insensitive) is at the position.
+	static bool IsUncPrefix(std::wstring_view path, size_t pos)
+	{
+		return path.length() >= pos + 3 && (path[pos] | 0x20) == L'u' && (path[pos + 1] | 0x20) == L'n' && (path[pos + 2] | 0x20) == L'c';
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// path : Path to be parsed.
+	// slash : True if a slash is also a separator.
+	// Returns : Length of the root of the path including its separator if any.
+	static size_t GetRootLength(std::wstring_view path, bool slash)
+	{
+		auto isSeparator{ [&path, slash](size_t pos) { return pos < path.length() && IsPathSeparator(path[pos], slash); } };
+
+		if (isSeparator(0) && isSeparator(1) && path.length() >= 4 && (path[2] == L'?' || path[2] == L'.') && isSeparator(3))
+		{
+			if (IsUncPrefix(path, 4) && isSeparator(7))
+			{
+				return SkipPathComponent(path, SkipPathComponent(path, 8, slash), slash);
+			}
+
+			if (path.length() >= 6 && IsDriveLetter(path[4]) && path[5] == L':')
+			{
+				return isSeparator(6) ? 7 : 6;
+			}
+
+			return SkipPathComponent(path, 4, slash);
+		}
+
+		if (isSeparator(0) && isSeparator(1))
+		{
+			return SkipPathComponent(path, SkipPathComponent(path, 2, slash), slash);
+		}
+
+		if (path.length() >= 2 && IsDriveLetter(path[0]) && path[1] == L':')
+		{
+			return isSeparator(2) ? 3 : 2;
+		}
+
+		return isSeparator(0) ? 1 : 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathView::Iterator::Iterator(std::wstring_view rest) : item_{}, rest_{}
+	{
+		auto first{ rest.find_first_not_of(BACKSLASH) };
+		if (first != std::wstring_view::npos)
+		{
+			item_ = rest.substr(first, rest.find(BACKSLASH, first) - first);
+			rest_ = rest.substr(first + item_.length());
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathView::PathView(std::wstring_view path) : path_{ path }, rootLength_{ GetRootLength(path, false) }, nameOffset_{ rootLength_ }
+	{
+		auto pos{ path_.find_last_of(BACKSLASH) };
+		if (pos != std::wstring_view::npos && pos >= rootLength_)
+		{
+			nameOffset_ = pos + 1;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view PathView::Parent() const
+	{
+		auto end{ nameOffset_ };
+
+		while (end > rootLength_ && path_[end - 1] == BACKSLASH)
+		{
+			--end;
+		}
+
+		return path_.substr(0, end);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view PathView::Extension() const
+	{
+		auto fileName{ FileName() };
+		auto pos{ fileName.find_last_of(L'.') };
+
+		if (pos == std::wstring_view::npos || pos == 0 || fileName == L"..")
+		{
+			return std::wstring_view{};
+		}
+
+		return fileName.substr(pos);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t NormalizePath(LPWSTR pPath, size_t length)
+	{
+		auto rootLength{ GetRootLength(std::wstring_view{ pPath, length }, true) };
+		auto rooted{ rootLength != 0 && !(rootLength == 2 && pPath[1] == L':') };
+
+		for (size_t i{ 0 }; i < rootLength; ++i)
+		{
+			if (pPath[i] == SLASH)
+			{
+				pPath[i] = BACKSLASH;
+			}
+		}
+
+		// The components are compacted toward the front, the write position never passes the read position.
+		auto write{ rootLength };
+		auto read{ rootLength };
+		auto directory{ false };
+
+		while (read < length)
+		{
+			auto start{ read };
+			while (read < length && !IsPathSeparator(pPath[read], true))
+			{
+				++read;
+			}
+
+			auto componentLength{ read - start };
+			directory = read < length;
+			read += directory ? 1 : 0;
+
+			if (componentLength == 0 || (componentLength == 1 && pPath[start] == L'.'))
+			{
+				directory = true;
+				continue;
+			}
+
+			if (componentLength == 2 && pPath[start] == L'.' && pPath[start + 1] == L'.')
+			{
+				auto last{ write };
+				while (last > rootLength && pPath[last - 1] != BACKSLASH)
+				{
+					--last;
+				}
+
+				auto isParent{ write - last == 2 && pPath[last] == L'.' && pPath[last + 1] == L'.' };
+
+				if (write > rootLength && !isParent)
+				{
+					write = last > rootLength ? last - 1 : rootLength;
+					directory = true;
+					continue;
+				}
+
+				if (rooted)
+				{
+					directory = true;
+					continue;
+				}
+			}
+
+			if (write > rootLength)
+			{
+				pPath[write++] = BACKSLASH;
+			}
+
+			std::copy(pPath + start, pPath + start + componentLength, pPath + write);
+			write += componentLength;
+		}
+
+		if (directory && write > rootLength && pPath[write - 1] != BACKSLASH)
+		{
+			pPath[write++] = BACKSLASH;
+		}
+
+		if (write == 0 && length != 0)
+		{
+			pPath[write++] = L'.';
+		}
+
+		return write;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring NormalizePath(std::wstring path, LongPathPrefix prefix)
+	{
+		path.resize(NormalizePath(&path[0], path.length()));
+
+		if (prefix == LongPathPrefix::Add && path.length() >= MAX_PATH)
+		{
+			if (IsDriveLetter(path[0]) && path[1] == L':' && path[2] == BACKSLASH)
+			{
+				path.insert(0, L"\\\\?\\");
+			}
+			else if (path[0] == BACKSLASH && path[1] == BACKSLASH && path[2] != L'?' && path[2] != L'.')
+			{
+				path.insert(2, L"?\\UNC\\");
+			}
+		}
+		else if (prefix == LongPathPrefix::Remove && path.compare(0, 4, L"\\\\?\\") == 0)
+		{
+			if (IsUncPrefix(path, 4) && path.length() > 7 && path[7] == BACKSLASH && path.length() - 6 < MAX_PATH)
+			{
+				path.erase(2, 6);
+			}
+			else if (path.length() >= 7 && IsDriveLetter(path[4]) && path[5] == L':' && path[6] == BACKSLASH && path.length() - 4 < MAX_PATH)
+			{
+				path.erase(0, 4);
+			}
+		}
+
+		return path;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring RenamePath(const std::wstring& fullPath, const std::wstring& newName)
+	{
+		auto pos{ fullPath.find_last_of(BACKSLASH) + 1 };
+
+		std::wstring renamedPath{};
+		renamedPath.reserve(pos + newName.length());
+
+		renamedPath.append(fullPath, 0, pos).append(newName);
+
+		return renamedPath;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring RenamePath(std::wstring_view fullPath, std::wstring_view newName, std::pmr::memory_resource* pResource)
+	{
+		auto pos{ fullPath.find_last_of(BACKSLASH) + 1 };
+
+		std::pmr::wstring renamedPath{ pResource };
+		renamedPath.reserve(pos + newName.length());
+
+		renamedPath.append(fullPath.substr(0, pos)).append(newName);
+
+		return renamedPath;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// parent : Parent node.
+	// name : Name of the child node.
+	// Returns : Hash of a child node (FNV-1a with a final mix since the table is indexed by the low bits).
+	static UINT HashPathNode(UINT parent, std::wstring_view name)
+	{
+		auto hash{ 2166136261u ^ parent };
+
+		for (auto chr : name)
+		{
+			hash = (hash ^ chr) * 16777619u;
+		}
+
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6Bu;
+		hash ^= hash >> 13;
+
+		return hash;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathTree::PathTree() : pNames_{ std::make_unique<StringArena>() }
+	{
+		Clear();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathTree::~PathTree()
+	{
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathTree::Add(std::wstring_view path)
+	{
+		PathView pathView{ path };
+		auto fileName{ pathView.FileName() };
+		auto node{ TOP_NODE };
+
+		// The items of a list are usually grouped by directory, so the directory of the previous item is tried first.
+		if (!fileName.empty() && lastParentNode_ != NO_NODE && pathView.Parent() == lastParent_)
+		{
+			node = AddChild(lastParentNode_, fileName);
+		}
+		else
+		{
+			if (!pathView.Root().empty())
+			{
+				node = AddChild(node, pathView.Root());
+			}
+
+			for (auto component : pathView)
+			{
+				node = AddChild(node, component);
+			}
+
+			if (!fileName.empty())
+			{
+				lastParent_.assign(pathView.Parent());
+				lastParentNode_ = nodes_[node].parent;
+			}
+		}
+
+		if (node == TOP_NODE || nodes_[node].item)
+		{
+			return false;
+		}
+
+		nodes_[node].item = true;
+		++itemCount_;
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t PathTree::Load(LPCWSTR pMultiSz)
+	{
+		size_t count{ 0 };
+
+		for (auto item : MultiSzView{ pMultiSz })
+		{
+			count += Add(item) ? 1 : 0;
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t PathTree::Load(const DropFilesList& dropFiles)
+	{
+		StringArena items{};
+		dropFiles.GetItems(items);
+
+		size_t count{ 0 };
+
+		for (auto item : items)
+		{
+			count += Add(item) ? 1 : 0;
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathTree::Clear()
+	{
+		pNames_->Clear();
+		pNames_->Add(std::wstring_view{});
+
+		nodes_.clear();
+		nodes_.push_back(Node{ 0, 0, NO_NODE, NO_NODE, NO_NODE, NO_NODE, false });
+
+		slots_.assign(64, NO_NODE);
+		lastParent_.clear();
+		lastParentNode_ = NO_NODE;
+		itemCount_ = 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathTree::Contains(std::wstring_view path) const
+	{
+		auto node{ Find(path) };
+		return node != NO_NODE && nodes_[node].item;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathTree::NodeId PathTree::Find(std::wstring_view path) const
+	{
+		PathView pathView{ path };
+		auto node{ TOP_NODE };
+
+		auto findChild{ [this, &node](std::wstring_view name)
+		{
+			node = slots_[FindSlot(node, name, HashPathNode(node, name))];
+			return node != NO_NODE;
+		} };
+
+		if (!pathView.Root().empty() && !findChild(pathView.Root()))
+		{
+			return NO_NODE;
+		}
+
+		for (auto component : pathView)
+		{
+			if (!findChild(component))
+			{
+				return NO_NODE;
+			}
+		}
+
+		return node != TOP_NODE ? node : NO_NODE;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view PathTree::GetName(NodeId node) const
+	{
+		return (*pNames_)[nodes_[node].name];
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathTree::GetPath(NodeId node, std::wstring& path) const
+	{
+		path.clear();
+
+		NodeId ancestors[64];
+		size_t count{ 0 };
+		std::vector<NodeId> deepAncestors{};
+
+		for (; node != TOP_NODE && node != NO_NODE; node = nodes_[node].parent)
+		{
+			if (count < std::size(ancestors))
+			{
+				ancestors[count++] = node;
+			}
+			else
+			{
+				deepAncestors.push_back(node);
+			}
+		}
+
+		for (auto it{ deepAncestors.rbegin() }; it != deepAncestors.rend(); ++it)
+		{
+			AppendName(*it, path);
+		}
+
+		while (count != 0)
+		{
+			AppendName(ancestors[--count], path);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t PathTree::GetMemoryUsage() const
+	{
+		auto size{ nodes_.capacity() * sizeof(Node) + slots_.capacity() * sizeof(NodeId) };
+
+		for (auto name : *pNames_)
+		{
+			size += (name.length() + 1) * sizeof(WCHAR) + sizeof(std::wstring_view);
+		}
+
+		return size;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathTree::AppendName(NodeId node, std::wstring& path) const
+	{
+		if (!path.empty() && path.back() != BACKSLASH)
+		{
+			path.push_back(BACKSLASH);
+		}
+
+		path.append(GetName(node));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t PathTree::FindSlot(NodeId parent, std::wstring_view name, UINT hash) const
+	{
+		auto mask{ slots_.size() - 1 };
+
+		for (auto slot{ hash & mask };; slot = (slot + 1) & mask)
+		{
+			auto node{ slots_[slot] };
+
+			if (node == NO_NODE || (nodes_[node].hash == hash && nodes_[node].parent == parent && GetName(node) == name))
+			{
+				return slot;
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathTree::NodeId PathTree::AddChild(NodeId parent, std::wstring_view name)
+	{
+		auto hash{ HashPathNode(parent, name) };
+		auto slot{ FindSlot(parent, name, hash) };
+
+		if (slots_[slot] != NO_NODE)
+		{
+			return slots_[slot];
+		}
+
+		auto node{ static_cast<NodeId>(nodes_.size()) };
+		auto nameIndex{ static_cast<UINT>(pNames_->size()) };
+		pNames_->Add(name);
+		nodes_.push_back(Node{ nameIndex, hash, parent, NO_NODE, NO_NODE, NO_NODE, false });
+
+		if (nodes_[parent].lastChild == NO_NODE)
+		{
+			nodes_[parent].firstChild = node;
+		}
+		else
+		{
+			nodes_[nodes_[parent].lastChild].nextSibling = node;
+		}
+
+		nodes_[parent].lastChild = node;
+
+		// The table is kept at most half full, it is rebuilt from the stored hashes when it grows.
+		if (nodes_.size() * 2 > slots_.size())
+		{
+			slots_.assign(slots_.size() * 2, NO_NODE);
+			auto mask{ slots_.size() - 1 };
+
+			for (NodeId other{ 1 }; other < nodes_.size(); ++other)
+			{
+				auto otherSlot{ nodes_[other].hash & mask };
+				while (slots_[otherSlot] != NO_NODE)
+				{
+					otherSlot = (otherSlot + 1) & mask;
+				}
+
+				slots_[otherSlot] = other;
+			}
+		}
+		else
+		{
+			slots_[slot] = node;
+		}
+
+		return node;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      string
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be processed.
+	// pBuffer : Buffer receiving the escaped string (str.length() + count of backslashes characters).
+	static void WriteEscapedBackslash(std::wstring_view str, LPWSTR pBuffer)
+	{
+		for (auto chr : str)
+		{
+			*pBuffer++ = chr;
+
+			if (chr == BACKSLASH)
+			{
+				*pBuffer++ = BACKSLASH;
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring EscapeBackslash(std::wstring str)
+	{
+		auto count{ static_cast<size_t>(std::count(str.begin(), str.end(), BACKSLASH)) };
+		if (count == 0)
+		{
+			return str;
+		}
+
+		std::wstring escaped(str.length() + count, L'\0');
+		WriteEscapedBackslash(str, &escaped[0]);
+
+		return escaped;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring EscapeBackslash(std::wstring_view str, std::pmr::memory_resource* pResource)
+	{
+		auto count{ static_cast<size_t>(std::count(str.begin(), str.end(), BACKSLASH)) };
+
+		std::pmr::wstring escaped(str.length() + count, L'\0', pResource);
+		WriteEscapedBackslash(str, &escaped[0]);
+
+		return escaped;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring JoinStrings(const std::vector<std::wstring>& strings, const std::wstring& separator, size_t)
+	{
+		return JoinStrings(strings, std::wstring_view{ separator });
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	static bool IsAvx2Supported()
+	{
+		int info[4];
+
+		CpuId(0, 0, info);
+		if (info[0] < 7)
+		{
+			return false;
+		}
+
+		// OSXSAVE and AVX, then YMM state enabled by the OS.
+		CpuId(1, 0, info);
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (GetEnabledXFeatures() & 6) != 6)
+		{
+			return false;
+		}
+
+		CpuId(7, 0, info);
+		return (info[1] & (1 << 5)) != 0;
+	}
+
+	static size_t PopCount(unsigned long long mask)
+	{
+		mask -= (mask >> 1) & 0x5555555555555555ull;
+		mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+		mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return static_cast<size_t>((mask * 0x0101010101010101ull) >> 56);
+	}
+
+	// Returns : Mask with one bit per byte of the 16 bytes block, set for each byte of a null code unit.
+	template <typename T>
+	HLP_NO_SANITIZE_ADDRESS static unsigned long long ZeroMaskSse2(const BYTE* pBlock)
+	{
+		auto block{ _mm_load_si128(reinterpret_cast<const __m128i*>(pBlock)) };
+		if constexpr (sizeof(T) == 1)
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128())));
+		}
+		else if constexpr (sizeof(T) == 2)
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(block, _mm_setzero_si128())));
+		}
+		else
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, _mm_setzero_si128())));
+		}
+	}
+
+	// Returns : Mask with one bit per byte of the 32 bytes block, set for each byte of a null code unit.
+	template <typename T>
+	HLP_AVX2 HLP_NO_SANITIZE_ADDRESS static unsigned long long ZeroMaskAvx2(const BYTE* pBlock)
+	{
+		auto block{ _mm256_load_si256(reinterpret_cast<const __m256i*>(pBlock)) };
+		if constexpr (sizeof(T) == 1)
+		{
+			return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_setzero_si256())));
+		}
+		else if constexpr (sizeof(T) == 2)
+		{
+			return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(block, _mm256_setzero_si256())));
+		}
+		else
+		{
+			return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, _mm256_setzero_si256())));
+		}
+	}
+
+	// Calls visit with the position of each null code unit of the mask (nothing is done if visit is nullptr).
+	template <typename T, typename Visit>
+	static void VisitNulls(const T* pMultiSz, const BYTE* pBlock, unsigned long long mask, Visit& visit)
+	{
+		if constexpr (!std::is_same_v<Visit, std::nullptr_t>)
+		{
+			for (; mask != 0; mask &= mask - 1)
+			{
+				visit(static_cast<size_t>(pBlock + GetLowestBit(mask) - reinterpret_cast<const BYTE*>(pMultiSz)) / sizeof(T));
+			}
+		}
+	}
+
+	// Scans aligned blocks for the double null terminator while counting the null separators.
+	// The blocks never cross a page boundary, so reading before the start or past the terminator is safe. The bytes before
+	// the start are masked out, those past the terminator are ignored, and the loads are hidden from AddressSanitizer.
+	// The zero mask is a template argument and the count a local, so the mask is inlined and the count stays in a register.
+	template <typename T, size_t WIDTH, unsigned long long (*ZeroMask)(const BYTE*), typename Visit>
+	HLP_FORCEINLINE static size_t ScanMultiSzBlocks(const T* pMultiSz, size_t maxCount, size_t& count, Visit& visit)
+	{
+		// Keeps the first bit of each code unit.
+		const unsigned long long unitMask{ sizeof(T) == 1 ? ~0ull : sizeof(T) == 2 ? 0x5555555555555555ull : 0x1111111111111111ull };
+
+		auto address{ reinterpret_cast<uintptr_t>(pMultiSz) };
+		auto pBlock{ reinterpret_cast<const BYTE*>(address & ~static_cast<uintptr_t>(WIDTH - 1)) };
+		auto mask{ ZeroMask(pBlock) & unitMask & (~0ull << (address & (WIDTH - 1))) };
+		unsigned long long carry{ 0 };
+		size_t found{ 0 };
+
+		for (;;)
+		{
+			auto pairs{ mask & ((mask << sizeof(T)) | carry) };
+			if (pairs != 0)
+			{
+				auto index{ GetLowestBit(pairs) };
+				auto separators{ mask & ((1ull << index) - 1) };
+				count = found + PopCount(separators);
+				VisitNulls(pMultiSz, pBlock, separators, visit);
+				return static_cast<size_t>(pBlock + index - reinterpret_cast<const BYTE*>(pMultiSz)) / sizeof(T) + 1;
+			}
+
+			found += PopCount(mask);
+			VisitNulls(pMultiSz, pBlock, mask, visit);
+			if (found >= maxCount)
+			{
+				count = found;
+				return 0;
+			}
+
+			carry = (mask >> (WIDTH - sizeof(T))) & 1;
+			pBlock += WIDTH;
+			mask = ZeroMask(pBlock) & unitMask;
+		}
+	}
+
+	// Scan compiled for AVX2 as a whole, so the zero mask is inlined in the loop.
+	template <typename T, typename Visit>
+	HLP_AVX2 static size_t ScanMultiSzAvx2(const T* pMultiSz, size_t maxCount, size_t& count, Visit& visit)
+	{
+		return ScanMultiSzBlocks<T, 32, ZeroMaskAvx2<T>>(pMultiSz, maxCount, count, visit);
+	}
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings (not null).
+	// maxCount : The scan stops once this count of strings is reached.
+	// count : Count of null-terminated strings in the sequence (up to maxCount).
+	// visit : Function called with the position of the null terminator of each string, or nullptr.
+	// Returns : Length of the sequence including the null terminator or 0 if the scan stopped at maxCount.
+	template <typename T, typename Visit = std::nullptr_t>
+	static size_t ScanMultiSz(const T* pMultiSz, size_t maxCount, size_t& count, Visit visit = nullptr)
+	{
+		count = 0;
+
+		if (*pMultiSz == 0)
+		{
+			return 1;
+		}
+
+		if (reinterpret_cast<uintptr_t>(pMultiSz) % sizeof(T) == 0)
+		{
+			static const bool avx2{ IsAvx2Supported() };
+			if (avx2)
+			{
+				return ScanMultiSzAvx2(pMultiSz, maxCount, count, visit);
+			}
+
+			return ScanMultiSzBlocks<T, 16, ZeroMaskSse2<T>>(pMultiSz, maxCount, count, visit);
+		}
+
+		// Misaligned wide strings can't be split into aligned blocks.
+		auto p{ pMultiSz };
+		while (*p)
+		{
+			if (++count >= maxCount)
+			{
+				return 0;
+			}
+
+			p += std::char_traits<T>::length(p);
+			if constexpr (!std::is_same_v<Visit, std::nullptr_t>)
+			{
+				visit(static_cast<size_t>(p - pMultiSz));
+			}
+
+			++p;
+		}
+
+		return (p - pMultiSz) + 1;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	static const WCHAR REPLACEMENT_CHARACTER{ 0xFFFD };
+
+	enum class Utf8Status { Valid, Invalid, Incomplete };
+
+	// pStr : Bytes of a sequence (the first one is not ASCII).
+	// length : Count of bytes available.
+	// codePoint : Decoded code point if the sequence is valid.
+	// used : Length of the sequence if valid or of its maximal valid prefix if invalid (to be replaced by U+FFFD).
+	// https://www.unicode.org/versions/Unicode13.0.0/ch03.pdf#G7404 (Table 3-7)
+	static Utf8Status DecodeUtf8Sequence(const BYTE* pStr, size_t length, char32_t& codePoint, size_t& used)
+	{
+		auto lead{ pStr[0] };
+		size_t sequenceLength;
+		BYTE low{ 0x80 };
+		BYTE high{ 0xBF };
+
+		used = 1;
+
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			sequenceLength = 2;
+			codePoint = lead & 0x1F;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			sequenceLength = 3;
+			codePoint = lead & 0x0F;
+			low = lead == 0xE0 ? 0xA0 : low;
+			high = lead == 0xED ? 0x9F : high;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			sequenceLength = 4;
+			codePoint = lead & 0x07;
+			low = lead == 0xF0 ? 0x90 : low;
+			high = lead == 0xF4 ? 0x8F : high;
+		}
+		else
+		{
+			return Utf8Status::Invalid;
+		}
+
+		for (; used < sequenceLength; ++used)
+		{
+			if (used == length)
+			{
+				return Utf8Status::Incomplete;
+			}
+
+			auto trail{ pStr[used] };
+			if (trail < low || trail > high)
+			{
+				return Utf8Status::Invalid;
+			}
+
+			codePoint = (codePoint << 6) | (trail & 0x3F);
+			low = 0x80;
+			high = 0xBF;
+		}
+
+		return Utf8Status::Valid;
+	}
+
+	static LPWSTR WriteUtf16(char32_t codePoint, LPWSTR pBuffer)
+	{
+		// A 32 bits WCHAR holds any code point (UTF-32).
+		if constexpr (sizeof(WCHAR) == 4)
+		{
+			*pBuffer++ = static_cast<WCHAR>(codePoint);
+		}
+		else if (codePoint < 0x10000)
+		{
+			*pBuffer++ = static_cast<WCHAR>(codePoint);
+		}
+		else
+		{
+			codePoint -= 0x10000;
+			*pBuffer++ = static_cast<WCHAR>(0xD800 + (codePoint >> 10));
+			*pBuffer++ = static_cast<WCHAR>(0xDC00 + (codePoint & 0x3FF));
+		}
+
+		return pBuffer;
+	}
+
+	// Returns : Count of leading ASCII bytes.
+	static size_t GetAsciiLength(const BYTE* pStr, size_t length)
+	{
+		size_t index{ 0 };
+
+		for (; index + 16 <= length; index += 16)
+		{
+			auto mask{ static_cast<unsigned long>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + index)))) };
+			if (mask != 0)
+			{
+				return index + GetLowestBit(mask);
+			}
+		}
+
+		while (index < length && pStr[index] < 0x80)
+		{
+			++index;
+		}
+
+		return index;
+	}
+
+	// pBuffer : Buffer receiving the UTF-16 characters (length characters at most).
+	// remaining : Length of an incomplete sequence left at the end of the string.
+	// Returns : Pointer past the last character written.
+	static LPWSTR DecodeUtf8(const BYTE* pStr, size_t length, LPWSTR pBuffer, size_t& remaining)
+	{
+		size_t index{ 0 };
+		remaining = 0;
+
+		while (index < length)
+		{
+			// The ASCII runs are widened in blocks.
+			auto asciiLength{ GetAsciiLength(pStr + index, length - index) };
+			WidenString(reinterpret_cast<LPCSTR>(pStr + index), asciiLength, pBuffer);
+			pBuffer += asciiLength;
+			index += asciiLength;
+
+			if (index == length)
+			{
+				break;
+			}
+
+			char32_t codePoint;
+			size_t used;
+			auto status{ DecodeUtf8Sequence(pStr + index, length - index, codePoint, used) };
+			if (status == Utf8Status::Incomplete)
+			{
+				remaining = length - index;
+				break;
+			}
+
+			pBuffer = status == Utf8Status::Valid ? WriteUtf16(codePoint, pBuffer) : WriteUtf16(REPLACEMENT_CHARACTER, pBuffer);
+			index += used;
+		}
+
+		return pBuffer;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be converted.
+	// codePage : Code page of the string.
+	// pBuffer : Buffer receiving the wide characters (str.length() characters is enough for any code page).
+	// Returns : Count of characters written.
+	static size_t ConvertToWide(std::string_view str, UINT codePage, LPWSTR pBuffer)
+	{
+		auto pStr{ reinterpret_cast<const BYTE*>(str.data()) };
+		auto length{ str.length() };
+
+		if (codePage == CP_UTF8)
+		{
+			size_t remaining;
+			auto pEnd{ DecodeUtf8(pStr, length, pBuffer, remaining) };
+			if (remaining != 0)
+			{
+				*pEnd++ = REPLACEMENT_CHARACTER;
+			}
+
+			return static_cast<size_t>(pEnd - pBuffer);
+		}
+
+		// The ANSI code pages are supersets of ASCII.
+		if (codePage == CP_ACP && GetAsciiLength(pStr, length) == length)
+		{
+			WidenString(str.data(), length, pBuffer);
+			return length;
+		}
+
+#ifdef _WIN32
+		if (length == 0 || length > INT_MAX)
+		{
+			return 0;
+		}
+
+		return static_cast<size_t>(MultiByteToWideChar(codePage, 0, str.data(), static_cast<int>(length), pBuffer, static_cast<int>(length)));
+#else
+		// The code pages of Windows aren't available, the other code pages are read as Latin-1.
+		WidenString(str.data(), length, pBuffer);
+		return length;
+#endif
+	}
+
+	// str : String to be converted.
+	// codePage : Code page of the string.
+	// Returns : Wide character string.
+	static std::wstring ConvertToWide(std::string_view str, UINT codePage)
+	{
+		std::wstring wideStr(str.length(), L'\0');
+		wideStr.resize(ConvertToWide(str, codePage, &wideStr[0]));
+
+		return wideStr;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool IsMultiSzItems(LPCSTR pMultiSz)
+	{
+		if (pMultiSz != nullptr)
+		{
+			size_t count;
+			ScanMultiSz(pMultiSz, 2, count);
+
+			return count > 1;
+		}
+
+		return false;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool IsMultiSzItems(LPCWSTR pMultiSz)
+	{
+		if (pMultiSz != nullptr)
+		{
+			size_t count;
+			ScanMultiSz(pMultiSz, 2, count);
+
+			return count > 1;
+		}
+
+		return false;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetMultiSzCount(LPCSTR pMultiSz)
+	{
+		size_t count{ 0 };
+
+		if (pMultiSz != nullptr)
+		{
+			ScanMultiSz(pMultiSz, SIZE_MAX, count);
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetMultiSzCount(LPCWSTR pMultiSz)
+	{
+		size_t count{ 0 };
+
+		if (pMultiSz != nullptr)
+		{
+			ScanMultiSz(pMultiSz, SIZE_MAX, count);
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns : Length of the sequence including the null terminator (see GetMultiSzOffsets).
+	template <typename T>
+	static size_t BuildMultiSzOffsets(const T* pMultiSz, std::vector<UINT32>& offsets)
+	{
+		offsets.clear();
+		offsets.push_back(0);
+
+		// Each null terminator is followed by the next item or by the final terminator.
+		size_t count;
+		return ScanMultiSz(pMultiSz, SIZE_MAX, count, [&offsets](size_t pos) { offsets.push_back(static_cast<UINT32>(pos + 1)); });
+	}
+
+	size_t GetMultiSzOffsets(LPCSTR pMultiSz, std::vector<UINT32>& offsets)
+	{
+		return BuildMultiSzOffsets(pMultiSz, offsets);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetMultiSzOffsets(LPCWSTR pMultiSz, std::vector<UINT32>& offsets)
+	{
+		return BuildMultiSzOffsets(pMultiSz, offsets);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetMultiSzSize(LPCSTR pMultiSz)
+	{
+		if (pMultiSz != nullptr)
+		{
+			size_t count;
+			return ScanMultiSz(pMultiSz, SIZE_MAX, count) * sizeof(CHAR);
+		}
+
+		return 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t GetMultiSzSize(LPCWSTR pMultiSz)
+	{
+		if (pMultiSz != nullptr)
+		{
+			size_t count;
+			return ScanMultiSz(pMultiSz, SIZE_MAX, count) * sizeof(WCHAR);
+		}
+
+		return 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<std::string> GetMultiSzItems(LPCSTR pMultiSz)
+	{
+		TraceScope trace{ L"GetMultiSzItems" };
+
+		std::vector<std::string> items{};
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.emplace_back(item);
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::vector<std::pmr::string> GetMultiSzItems(LPCSTR pMultiSz, std::pmr::memory_resource* pResource)
+	{
+		std::pmr::vector<std::pmr::string> items{ pResource };
+		items.reserve(GetMultiSzCount(pMultiSz));
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.emplace_back(item);
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Zero extends the bytes into a new string. Short strings are widened by the constructor,
+	// which is cheaper than zero filling the string and widening it again.
+	static std::wstring WidenToString(LPCSTR pStr, size_t length)
+	{
+		if (length < 32)
+		{
+			auto pSrc{ reinterpret_cast<const BYTE*>(pStr) };
+			return std::wstring(pSrc, pSrc + length);
+		}
+
+		std::wstring str(length, L'\0');
+		WidenString(pStr, length, &str[0]);
+
+		return str;
+	}
+
+	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz)
+	{
+		std::vector<std::wstring> items{};
+		items.reserve(GetMultiSzCount(pMultiSz));
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.push_back(WidenToString(item.data(), item.length()));
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage)
+	{
+		std::vector<std::wstring> items{};
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.push_back(ConvertToWide(item, codePage));
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage, StringArena& items)
+	{
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.Commit(ConvertToWide(item, codePage, items.Reserve(item.length())));
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::vector<std::pmr::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage, std::pmr::memory_resource* pResource)
+	{
+		std::pmr::vector<std::pmr::wstring> items{ pResource };
+		items.reserve(GetMultiSzCount(pMultiSz));
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			auto& wideItem{ items.emplace_back(item.length(), L'\0') };
+			wideItem.resize(ConvertToWide(item, codePage, &wideItem[0]));
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<std::wstring> GetMultiSzItems(LPCWSTR pMultiSz)
+	{
+		TraceScope trace{ L"GetMultiSzItems" };
+
+		std::vector<std::wstring> items{};
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.emplace_back(item);
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GetMultiSzItems(LPCWSTR pMultiSz, StringArena& items)
+	{
+		TraceScope trace{ L"GetMultiSzItems" };
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.Add(item);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::vector<std::pmr::wstring> GetMultiSzItems(LPCWSTR pMultiSz, std::pmr::memory_resource* pResource)
+	{
+		std::pmr::vector<std::pmr::wstring> items{ pResource };
+		items.reserve(GetMultiSzCount(pMultiSz));
+
+		for (const auto& item : MultiSzView{ pMultiSz })
+		{
+			items.emplace_back(item);
+		}
+
+		return items;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	StringArena::StringArena(std::pmr::memory_resource* pResource) :
+		pResource_{ pResource }, blocks_{ pResource }, items_{ pResource }, pNext_{ nullptr }, available_{ 0 }
+	{
+	}
+
+	StringArena::~StringArena()
+	{
+		Clear();
+	}
+
+	std::wstring_view StringArena::Add(std::wstring_view str)
+	{
+		return Commit(str.copy(Reserve(str.length()), str.length()));
+	}
+
+	LPWSTR StringArena::Reserve(size_t maxLength)
+	{
+		if (available_ <= maxLength)
+		{
+			auto blockLength{ (std::max)(BLOCK_LENGTH, maxLength + 1) };
+
+			// The list grows first, so the block can't leak if the list fails to grow.
+			if (blocks_.size() == blocks_.capacity())
+			{
+				blocks_.reserve(blocks_.size() * 2 + 1);
+			}
+
+			pNext_ = static_cast<LPWSTR>(pResource_->allocate(blockLength * sizeof(WCHAR), alignof(WCHAR)));
+			blocks_.push_back(Block{ pNext_, blockLength });
+			available_ = blockLength;
+		}
+
+		return pNext_;
+	}
+
+	std::wstring_view StringArena::Commit(size_t length)
+	{
+		pNext_[length] = L'\0';
+		auto& item{ items_.emplace_back(pNext_, length) };
+		pNext_ += length + 1;
+		available_ -= length + 1;
+
+		return item;
+	}
+
+	void StringArena::Clear()
+	{
+		for (const auto& block : blocks_)
+		{
+			pResource_->deallocate(block.pBuffer, block.length * sizeof(WCHAR), alignof(WCHAR));
+		}
+
+		items_.clear();
+		blocks_.clear();
+		pNext_ = nullptr;
+		available_ = 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimString(std::wstring str, WCHAR chr)
+	{
+		return str.erase(str.find_last_not_of(chr) + 1).erase(0, str.find_first_not_of(chr));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimStringBack(std::wstring str, WCHAR chr)
+	{
+		return str.erase(str.find_last_not_of(chr) + 1);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimStringFront(std::wstring str, WCHAR chr)
+	{
+		return str.erase(0, str.find_first_not_of(chr));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Above this count of characters in the set, the comparisons per block cost more than the scalar search.
+	static const size_t MAX_SIMD_TRIM_CHARS{ 8 };
+
+	// Returns : Count of leading characters of the string found in chars.
+	template <typename T>
+	static size_t SpanFront(const T* pStr, size_t length, std::basic_string_view<T> chars)
+	{
+		size_t index{ 0 };
+
+		if constexpr (sizeof(T) == 2)
+		{
+			if (chars.length() <= MAX_SIMD_TRIM_CHARS)
+			{
+				while (index + 8 <= length)
+				{
+					auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + index)) };
+					auto found{ _mm_setzero_si128() };
+					for (auto chr : chars)
+					{
+						found = _mm_or_si128(found, _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(chr))));
+					}
+
+					auto mask{ static_cast<unsigned long>(_mm_movemask_epi8(found)) };
+					if (mask != 0xFFFF)
+					{
+						return index + GetLowestBit(~mask) / 2;
+					}
+
+					index += 8;
+				}
+			}
+		}
+
+		while (index < length && chars.find(pStr[index]) != chars.npos)
+		{
+			++index;
+		}
+
+		return index;
+	}
+
+	// Returns : Length of the string without the trailing characters found in chars.
+	template <typename T>
+	static size_t SpanBack(const T* pStr, size_t length, std::basic_string_view<T> chars)
+	{
+		if constexpr (sizeof(T) == 2)
+		{
+			if (chars.length() <= MAX_SIMD_TRIM_CHARS)
+			{
+				while (length >= 8)
+				{
+					auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + length - 8)) };
+					auto found{ _mm_setzero_si128() };
+					for (auto chr : chars)
+					{
+						found = _mm_or_si128(found, _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(chr))));
+					}
+
+					auto mask{ static_cast<unsigned long>(_mm_movemask_epi8(found)) };
+					if (mask != 0xFFFF)
+					{
+						return length - 8 + GetHighestBit(~mask & 0xFFFF) / 2 + 1;
+					}
+
+					length -= 8;
+				}
+			}
+		}
+
+		while (length > 0 && chars.find(pStr[length - 1]) != chars.npos)
+		{
+			--length;
+		}
+
+		return length;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimString(std::wstring str, std::wstring_view chars)
+	{
+		str.erase(SpanBack(str.data(), str.length(), chars));
+		return str.erase(0, SpanFront(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimString(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringView(str, chr), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimString(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringView(str, chars), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimStringBack(std::wstring str, std::wstring_view chars)
+	{
+		return str.erase(SpanBack(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimStringBack(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringBackView(str, chr), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimStringBack(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringBackView(str, chars), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring TrimStringFront(std::wstring str, std::wstring_view chars)
+	{
+		return str.erase(0, SpanFront(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimStringFront(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringFrontView(str, chr), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring TrimStringFront(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource)
+	{
+		return std::pmr::wstring{ TrimStringFrontView(str, chars), pResource };
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view TrimStringView(std::wstring_view str, std::wstring_view chars)
+	{
+		return TrimStringFrontView(TrimStringBackView(str, chars), chars);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view TrimStringBackView(std::wstring_view str, std::wstring_view chars)
+	{
+		return str.substr(0, SpanBack(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring_view TrimStringFrontView(std::wstring_view str, std::wstring_view chars)
+	{
+		return str.substr(SpanFront(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::u16string_view TrimStringView(std::u16string_view str, std::u16string_view chars)
+	{
+		return TrimStringFrontView(TrimStringBackView(str, chars), chars);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::u16string_view TrimStringBackView(std::u16string_view str, std::u16string_view chars)
+	{
+		return str.substr(0, SpanBack(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::u16string_view TrimStringFrontView(std::u16string_view str, std::u16string_view chars)
+	{
+		return str.substr(SpanFront(str.data(), str.length(), chars));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring WStrFromStr(LPCSTR pStr)
+	{
+		return WidenToString(pStr, strlen(pStr));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Zero extends the bytes by blocks of 32.
+	// Returns : Count of bytes widened.
+	template <typename T>
+	HLP_AVX2 static size_t WidenBlocksAvx2(const BYTE* pSrc, size_t length, T* pBuffer)
+	{
+		size_t index{ 0 };
+
+		for (; index + 32 <= length; index += 32)
+		{
+			if constexpr (sizeof(T) == 2)
+			{
+				auto low{ _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + index))) };
+				auto high{ _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + index + 16))) };
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pBuffer + index), low);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pBuffer + index + 16), high);
+			}
+			else
+			{
+				for (size_t offset{ 0 }; offset < 32; offset += 8)
+				{
+					auto block{ _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + index + offset))) };
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(pBuffer + index + offset), block);
+				}
+			}
+		}
+
+		return index;
+	}
+
+	// Zero extends the bytes to 16 or 32 bits code units (Latin-1 to UTF-16 or UTF-32).
+	template <typename T>
+	static void WidenCodeUnits(LPCSTR pStr, size_t length, T* pBuffer)
+	{
+		auto pSrc{ reinterpret_cast<const BYTE*>(pStr) };
+		size_t index{ 0 };
+
+		static const bool avx2{ IsAvx2Supported() };
+		if (avx2)
+		{
+			index = WidenBlocksAvx2(pSrc, length, pBuffer);
+		}
+
+		for (; index + 16 <= length; index += 16)
+		{
+			auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + index)) };
+			auto low{ _mm_unpacklo_epi8(block, _mm_setzero_si128()) };
+			auto high{ _mm_unpackhi_epi8(block, _mm_setzero_si128()) };
+
+			if constexpr (sizeof(T) == 2)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index), low);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index + 8), high);
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index), _mm_unpacklo_epi16(low, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index + 4), _mm_unpackhi_epi16(low, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index + 8), _mm_unpacklo_epi16(high, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBuffer + index + 12), _mm_unpackhi_epi16(high, _mm_setzero_si128()));
+			}
+		}
+
+		for (; index < length; ++index)
+		{
+			pBuffer[index] = pSrc[index];
+		}
+	}
+
+	void WidenString(LPCSTR pStr, size_t length, LPWSTR pBuffer)
+	{
+		WidenCodeUnits(pStr, length, pBuffer);
+	}
+
+	void WidenString(LPCSTR pStr, size_t length, char16_t* pBuffer)
+	{
+		WidenCodeUnits(pStr, length, pBuffer);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring WStrFromStr(LPCSTR pStr, UINT codePage)
+	{
+		return ConvertToWide(std::string_view{ pStr }, codePage);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pmr::wstring WStrFromStr(LPCSTR pStr, UINT codePage, std::pmr::memory_resource* pResource)
+	{
+		std::string_view str{ pStr };
+		std::pmr::wstring wideStr(str.length(), L'\0', pResource);
+		wideStr.resize(ConvertToWide(str, codePage, &wideStr[0]));
+
+		return wideStr;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool IsValidUtf8(std::string_view str)
+	{
+		auto pStr{ reinterpret_cast<const BYTE*>(str.data()) };
+		auto length{ str.length() };
+		size_t index{ 0 };
+
+		while (index < length)
+		{
+			index += GetAsciiLength(pStr + index, length - index);
+
+			if (index < length)
+			{
+				char32_t codePoint;
+				size_t used;
+				if (DecodeUtf8Sequence(pStr + index, length - index, codePoint, used) != Utf8Status::Valid)
+				{
+					return false;
+				}
+
+				index += used;
+			}
+		}
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::wstring Utf8ToUtf16(std::string_view str)
+	{
+		return ConvertToWide(str, CP_UTF8);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Encodes UTF-16 or UTF-32 code units (WCHAR or char16_t) to UTF-8.
+	template <typename T>
+	static std::string EncodeUtf8(std::basic_string_view<T> str)
+	{
+		// A UTF-16 character never takes more than 3 bytes (a surrogate pair takes 4 bytes for 2 characters), a UTF-32 character 4 bytes.
+		std::string narrowStr(str.length() * (sizeof(T) == 2 ? 3 : 4), '\0');
+
+		auto pBuffer{ reinterpret_cast<BYTE*>(&narrowStr[0]) };
+		auto length{ str.length() };
+		size_t index{ 0 };
+
+		while (index < length)
+		{
+			// The ASCII runs are narrowed 16 bytes at a time.
+			constexpr size_t BLOCK_LENGTH{ 16 / sizeof(T) };
+			while (index + BLOCK_LENGTH <= length)
+			{
+				auto block{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + index)) };
+
+				if constexpr (sizeof(T) == 2)
+				{
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(block, _mm_set1_epi16(0x7F)), _mm_setzero_si128())) != 0xFFFF)
+					{
+						break;
+					}
+
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pBuffer), _mm_packus_epi16(block, block));
+				}
+				else
+				{
+					if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(block, _mm_set1_epi32(~0x7F)), _mm_setzero_si128())) != 0xFFFF)
+					{
+						break;
+					}
+
+					auto packed{ _mm_packs_epi32(block, block) };
+					auto ascii{ _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed)) };
+					memcpy(pBuffer, &ascii, sizeof(ascii));
+				}
+
+				pBuffer += BLOCK_LENGTH;
+				index += BLOCK_LENGTH;
+			}
+
+			if (index == length)
+			{
+				break;
+			}
+
+			auto codePoint{ static_cast<char32_t>(str[index++]) };
+
+			if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+			{
+				if (codePoint <= 0xDBFF && index < length && str[index] >= 0xDC00 && str[index] <= 0xDFFF)
+				{
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (str[index++] - 0xDC00);
+				}
+				else
+				{
+					codePoint = REPLACEMENT_CHARACTER;
+				}
+			}
+			else if (codePoint > 0x10FFFF)
+			{
+				// Not a code point (UTF-32 only).
+				codePoint = REPLACEMENT_CHARACTER;
+			}
+
+			if (codePoint < 0x80)
+			{
+				*pBuffer++ = static_cast<BYTE>(codePoint);
+			}
+			else if (codePoint < 0x800)
+			{
+				*pBuffer++ = static_cast<BYTE>(0xC0 | (codePoint >> 6));
+				*pBuffer++ = static_cast<BYTE>(0x80 | (codePoint & 0x3F));
+			}
+			else if (codePoint < 0x10000)
+			{
+				*pBuffer++ = static_cast<BYTE>(0xE0 | (codePoint >> 12));
+				*pBuffer++ = static_cast<BYTE>(0x80 | ((codePoint >> 6) & 0x3F));
+				*pBuffer++ = static_cast<BYTE>(0x80 | (codePoint & 0x3F));
+			}
+			else
+			{
+				*pBuffer++ = static_cast<BYTE>(0xF0 | (codePoint >> 18));
+				*pBuffer++ = static_cast<BYTE>(0x80 | ((codePoint >> 12) & 0x3F));
+				*pBuffer++ = static_cast<BYTE>(0x80 | ((codePoint >> 6) & 0x3F));
+				*pBuffer++ = static_cast<BYTE>(0x80 | (codePoint & 0x3F));
+			}
+		}
+
+		narrowStr.resize(static_cast<size_t>(pBuffer - reinterpret_cast<BYTE*>(&narrowStr[0])));
+		return narrowStr;
+	}
+
+	std::string Utf16ToUtf8(std::wstring_view str)
+	{
+		return EncodeUtf8(str);
+	}
+
+	std::string Utf16ToUtf8(std::u16string_view str)
+	{
+		return EncodeUtf8(str);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	Utf8Decoder::Utf8Decoder() : pending_{}, pendingLength_{ 0 }
+	{
+	}
+
+	size_t Utf8Decoder::Decode(std::string_view chunk, LPWSTR pBuffer)
+	{
+		auto pStr{ reinterpret_cast<const BYTE*>(chunk.data()) };
+		auto length{ chunk.length() };
+		auto pFirst{ pBuffer };
+
+		// Completes the sequence left by the previous chunk.
+		while (pendingLength_ != 0 && length != 0)
+		{
+			BYTE sequence[4];
+			auto taken{ (std::min)(length, sizeof(sequence) - pendingLength_) };
+			memcpy(sequence, pending_, pendingLength_);
+			memcpy(sequence + pendingLength_, pStr, taken);
+
+			char32_t codePoint;
+			size_t used;
+			auto status{ DecodeUtf8Sequence(sequence, pendingLength_ + taken, codePoint, used) };
+			if (status == Utf8Status::Incomplete)
+			{
+				memcpy(pending_ + pendingLength_, pStr, taken);
+				pendingLength_ += taken;
+				return 0;
+			}
+
+			// The pending bytes are a valid prefix, so the sequence always ends in the new chunk.
+			pBuffer = status == Utf8Status::Valid ? WriteUtf16(codePoint, pBuffer) : WriteUtf16(REPLACEMENT_CHARACTER, pBuffer);
+			pStr += used - pendingLength_;
+			length -= used - pendingLength_;
+			pendingLength_ = 0;
+		}
+
+		size_t remaining;
+		pBuffer = DecodeUtf8(pStr, length, pBuffer, remaining);
+
+		memcpy(pending_, pStr + length - remaining, remaining);
+		pendingLength_ = remaining;
+
+		return static_cast<size_t>(pBuffer - pFirst);
+	}
+
+	void Utf8Decoder::Decode(std::string_view chunk, std::wstring& str)
+	{
+		auto offset{ str.length() };
+		str.resize(offset + GetMaxLength(chunk.length()));
+		str.resize(offset + Decode(chunk, &str[offset]));
+	}
+
+	size_t Utf8Decoder::Finish(LPWSTR pBuffer)
+	{
+		if (pendingLength_ != 0)
+		{
+			pendingLength_ = 0;
+			*pBuffer = REPLACEMENT_CHARACTER;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      thread
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	WorkerPool::WorkerPool() : maxThreads_{ (std::max)(std::thread::hardware_concurrency(), 1u) }, busy_{ 0 }, stop_{ false }
+	{
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			stop_ = true;
+		}
+
+		jobReady_.notify_all();
+
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	WorkerPool& WorkerPool::GetShared()
+	{
+		static WorkerPool pool{};
+		return pool;
+	}
+
+	void WorkerPool::Run(size_t workerCount, const std::function<void(size_t)>& work, const std::function<void()>& local)
+	{
+		// Guarded by mutex_ like the queue, the threads don't touch it once remaining is 0.
+		Batch batch{ &work, workerCount, nullptr };
+
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+
+			for (size_t worker{ 0 }; worker < workerCount; ++worker)
+			{
+				jobs_.push_back(Job{ &batch, worker });
+			}
+
+			// The jobs left queued when all the threads are busy are run by the caller.
+			while (threads_.size() - busy_ < jobs_.size() && threads_.size() < maxThreads_)
+			{
+				threads_.emplace_back(&WorkerPool::ThreadProc, this);
+			}
+		}
+
+		jobReady_.notify_all();
+
+		std::exception_ptr localException{};
+		try
+		{
+			local();
+		}
+		catch (...)
+		{
+			localException = std::current_exception();
+		}
+
+		{
+			// The jobs refer to this frame, so they are run or waited for even if local has thrown.
+			std::unique_lock<std::mutex> lock{ mutex_ };
+
+			for (;;)
+			{
+				auto job{ std::find_if(jobs_.begin(), jobs_.end(), [&batch](const Job& job) { return job.pBatch == &batch; }) };
+				if (job == jobs_.end())
+				{
+					break;
+				}
+
+				auto worker{ job->worker };
+				jobs_.erase(job);
+
+				lock.unlock();
+
+				std::exception_ptr exception{};
+				try
+				{
+					work(worker);
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				lock.lock();
+
+				if (exception != nullptr && batch.exception == nullptr)
+				{
+					batch.exception = exception;
+				}
+
+				--batch.remaining;
+			}
+
+			jobDone_.wait(lock, [&batch] { return batch.remaining == 0; });
+		}
+
+		if (localException != nullptr)
+		{
+			std::rethrow_exception(localException);
+		}
+
+		if (batch.exception != nullptr)
+		{
+			std::rethrow_exception(batch.exception);
+		}
+	}
+
+	void WorkerPool::ThreadProc()
+	{
+		std::unique_lock<std::mutex> lock{ mutex_ };
+
+		for (;;)
+		{
+			jobReady_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+			if (jobs_.empty())
+			{
+				return;
+			}
+
+			auto job{ jobs_.front() };
+			jobs_.pop_front();
+			++busy_;
+
+			lock.unlock();
+
+			std::exception_ptr exception{};
+			try
+			{
+				(*job.pBatch->pWork)(job.worker);
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			lock.lock();
+
+			--busy_;
+			if (exception != nullptr && job.pBatch->exception == nullptr)
+			{
+				job.pBatch->exception = exception;
+			}
+
+			--job.pBatch->remaining;
+			jobDone_.notify_all();
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	WorkStealingQueue::WorkStealingQueue(size_t count, size_t workerCount, size_t chunkSize) :
+		ranges_{ new Range[workerCount] }, workerCount_{ workerCount }, count_{ count }, chunkSize_{ chunkSize }, next_{ 0 }
+	{
+		for (size_t worker{ 0 }; worker < workerCount_; ++worker)
+		{
+			ranges_[worker].begin = 0;
+			ranges_[worker].end = 0;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool WorkStealingQueue::Pop(size_t worker, size_t& index)
+	{
+		auto& own{ ranges_[worker] };
+
+		{
+			std::lock_guard<std::mutex> lock{ own.mutex };
+			if (own.begin != own.end)
+			{
+				index = own.begin++;
+				return true;
+			}
+		}
+
+		if (next_.load(std::memory_order_relaxed) < count_)
+		{
+			auto begin{ next_.fetch_add(chunkSize_, std::memory_order_relaxed) };
+			if (begin < count_)
+			{
+				std::lock_guard<std::mutex> lock{ own.mutex };
+				own.begin = begin + 1;
+				own.end = (std::min)(begin + chunkSize_, count_);
+				index = begin;
+
+				return true;
+			}
+		}
+
+		// The ranges are locked one at a time, so the victim is checked again when stealing from it.
+		size_t victim{ worker };
+		size_t victimBegin{ count_ };
+
+		for (size_t other{ 0 }; other < workerCount_; ++other)
+		{
+			if (other != worker)
+			{
+				std::lock_guard<std::mutex> lock{ ranges_[other].mutex };
+				if (ranges_[other].begin != ranges_[other].end && ranges_[other].begin < victimBegin)
+				{
+					victim = other;
+					victimBegin = ranges_[other].begin;
+				}
+			}
+		}
+
+		if (victim == worker)
+		{
+			return false;
+		}
+
+		size_t begin;
+		size_t end;
+
+		{
+			auto& range{ ranges_[victim] };
+			std::lock_guard<std::mutex> lock{ range.mutex };
+			if (range.begin == range.end)
+			{
+				return Pop(worker, index);
+			}
+
+			// The front half holds the indices the consumer needs first.
+			begin = range.begin;
+			end = range.begin + (range.end - range.begin + 1) / 2;
+			range.begin = end;
+		}
+
+		std::lock_guard<std::mutex> lock{ own.mutex };
+		own.begin = begin + 1;
+		own.end = end;
+		index = begin;
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      trace
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Count of events per thread (power of 2) and size of the output written at once.
+	static const size_t TRACE_BUFFER_CAPACITY{ 4096 };
+	static const size_t TRACE_OUTPUT_SIZE{ 64 * 1024 };
+
+#ifdef _WIN32
+	using TraceFile = HANDLE;
+#else
+	using TraceFile = std::FILE*;
+#endif
+
+	// pFilePath : Path of the file to be created or truncated.
+	// Returns : File opened for writing or nullptr if it can't be created.
+	static TraceFile CreateTraceFile(LPCWSTR pFilePath)
+	{
+#ifdef _WIN32
+		auto hFile{ CreateFileW(pFilePath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		return hFile != INVALID_HANDLE_VALUE ? hFile : nullptr;
+#else
+		return std::fopen(Utf16ToUtf8(pFilePath).c_str(), "wb");
+#endif
+	}
+
+	// Returns : True if all the bytes have been written.
+	static bool WriteTraceFile(TraceFile hFile, const char* pData, size_t nBytes)
+	{
+#ifdef _WIN32
+		size_t written{ 0 };
+
+		while (written < nBytes)
+		{
+			auto nChunk{ static_cast<DWORD>((std::min)(nBytes - written, size_t{ MAXDWORD })) };
+			DWORD nWritten;
+
+			if (!WriteFile(hFile, pData + written, nChunk, &nWritten, nullptr) || nWritten == 0)
+			{
+				return false;
+			}
+
+			written += nWritten;
+		}
+
+		return true;
+#else
+		return std::fwrite(pData, 1, nBytes, hFile) == nBytes;
+#endif
+	}
+
+	// Returns : True if the file has been closed without error.
+	static bool CloseTraceFile(TraceFile hFile)
+	{
+#ifdef _WIN32
+		return CloseHandle(hFile) != FALSE;
+#else
+		return std::fclose(hFile) == 0;
+#endif
+	}
+
+	static DWORD GetTraceThreadId()
+	{
+#ifdef _WIN32
+		return GetCurrentThreadId();
+#else
+		return static_cast<DWORD>(syscall(SYS_gettid));
+#endif
+	}
+
+	static DWORD GetTraceProcessId()
+	{
+#ifdef _WIN32
+		return GetCurrentProcessId();
+#else
+		return static_cast<DWORD>(getpid());
+#endif
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct TraceRecord
+	{
+		LPCWSTR pName;
+		UINT64 timestamp;
+		TraceEventType type;
+	};
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4324) // The padding is intended, the indices written by different threads have their own cache line.
+#endif
+	// Single producer (its thread) single consumer (the flusher) ring buffer.
+	struct TraceBuffer
+	{
+		alignas(64) std::atomic<size_t> head;
+		alignas(64) std::atomic<size_t> tail;
+		DWORD threadId;
+		// Set when its thread exits, the buffer is then reused by a new thread once its last events have been written.
+		std::atomic<bool> retired;
+		TraceRecord records[TRACE_BUFFER_CAPACITY];
+	};
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+	// The buffers are shared with their threads, so a thread exiting after the state has been destroyed doesn't use it.
+	struct TraceState
+	{
+		// Stops a trace still being recorded when the program exits, the flusher must not outlive the state.
+		~TraceState();
+		std::mutex sessionMutex;
+		std::mutex buffersMutex;
+		std::vector<std::shared_ptr<TraceBuffer>> buffers;
+		std::vector<TraceBuffer*> drainedBuffers;
+		std::atomic<UINT64> dropped{ 0 };
+		std::mutex flusherMutex;
+		std::condition_variable flusherWake;
+		std::thread flusher;
+		bool stop{ false };
+		TraceFile hFile{ nullptr };
+		TraceFormat format{ TraceFormat::Json };
+		bool failed{ false };
+		UINT64 startTimestamp{ 0 };
+		size_t eventCount{ 0 };
+		std::string output;
+		std::unordered_map<LPCWSTR, UINT32> nameIds;
+		std::vector<std::string> jsonNames;
+	};
+
+	static TraceState& GetTraceState()
+	{
+		static TraceState state{};
+		return state;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Buffer of the calling thread, retired when the thread exits.
+	class TraceBufferOwner
+	{
+	public:
+		TraceBufferOwner() : pBuffer_{} {}
+
+		~TraceBufferOwner()
+		{
+			if (pBuffer_)
+			{
+				pBuffer_->retired.store(true, std::memory_order_release);
+			}
+		}
+
+		TraceBuffer& Get()
+		{
+			if (!pBuffer_)
+			{
+				auto& state{ GetTraceState() };
+				std::lock_guard<std::mutex> lock{ state.buffersMutex };
+
+				// A retired buffer is reused only when all its events have been written, so they keep their thread id.
+				auto it{ std::find_if(state.buffers.begin(), state.buffers.end(), [](const auto& pBuffer)
+				{
+					return pBuffer->retired.load(std::memory_order_acquire) &&
+						pBuffer->tail.load(std::memory_order_acquire) == pBuffer->head.load(std::memory_order_relaxed);
+				}) };
+
+				if (it != state.buffers.end())
+				{
+					pBuffer_ = *it;
+				}
+				else
+				{
+					state.buffers.push_back(std::make_shared<TraceBuffer>());
+					pBuffer_ = state.buffers.back();
+				}
+
+				pBuffer_->threadId = GetTraceThreadId();
+				pBuffer_->retired.store(false, std::memory_order_relaxed);
+			}
+
+			return *pBuffer_;
+		}
+	private:
+		std::shared_ptr<TraceBuffer> pBuffer_;
+	};
+
+	static TraceBuffer& GetTraceBuffer()
+	{
+		thread_local TraceBufferOwner owner{};
+		return owner.Get();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RecordTraceEvent(LPCWSTR pName, TraceEventType type)
+	{
+		if (!IsTraceEnabled())
+		{
+			return;
+		}
+
+		auto& buffer{ GetTraceBuffer() };
+		auto head{ buffer.head.load(std::memory_order_relaxed) };
+
+		if (head - buffer.tail.load(std::memory_order_acquire) == TRACE_BUFFER_CAPACITY)
+		{
+			GetTraceState().dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto timestamp{ static_cast<UINT64>(TscClock::now().time_since_epoch().count()) };
+		buffer.records[head % TRACE_BUFFER_CAPACITY] = TraceRecord{ pName, timestamp, type };
+		buffer.head.store(head + 1, std::memory_order_release);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	static void AppendTraceValue(std::string& output, T value)
+	{
+		output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns : Name converted to UTF-8 and escaped as a JSON string.
+	static std::string GetTraceJsonName(LPCWSTR pName)
+	{
+		std::string name{};
+
+		for (auto chr : Utf16ToUtf8(pName))
+		{
+			if (chr == '\"' || chr == '\\')
+			{
+				name += '\\';
+				name += chr;
+			}
+			else if (static_cast<unsigned char>(chr) < 0x20)
+			{
+				const char digits[]{ "0123456789abcdef" };
+				name += "\\u00";
+				name += digits[chr >> 4];
+				name += digits[chr & 0xF];
+			}
+			else
+			{
+				name += chr;
+			}
+		}
+
+		return name;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	static void WriteTraceOutput(TraceState& state)
+	{
+		if (!state.failed)
+		{
+			state.failed = !WriteTraceFile(state.hFile, state.output.data(), state.output.length());
+		}
+
+		state.output.clear();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	static void WriteTraceRecord(TraceState& state, DWORD threadId, const TraceRecord& record)
+	{
+		auto name{ state.nameIds.find(record.pName) };
+
+		if (name == state.nameIds.end())
+		{
+			auto id{ static_cast<UINT32>(state.nameIds.size()) };
+			name = state.nameIds.emplace(record.pName, id).first;
+
+			if (state.format == TraceFormat::Json)
+			{
+				state.jsonNames.push_back(GetTraceJsonName(record.pName));
+			}
+			else
+			{
+				auto utf8Name{ Utf16ToUtf8(record.pName) };
+				AppendTraceValue(state.output, BYTE{ 0 });
+				AppendTraceValue(state.output, id);
+				AppendTraceValue(state.output, static_cast<UINT32>(utf8Name.length()));
+				state.output += utf8Name;
+			}
+		}
+
+		// Events recorded before the trace has been started don't go below 0.
+		auto timestamp{ record.timestamp > state.startTimestamp ? record.timestamp - state.startTimestamp : 0 };
+
+		if (state.format == TraceFormat::Json)
+		{
+			const char phases[]{ 'B', 'E', 'i' };
+
+			state.output += state.eventCount != 0 ? ",\n{\"name\":\"" : "{\"name\":\"";
+			state.output += state.jsonNames[name->second];
+			state.output += "\",\"ph\":\"";
+			state.output += phases[static_cast<size_t>(record.type)];
+			state.output += "\",\"ts\":" + std::to_string(timestamp / 1000) + '.';
+			state.output += static_cast<char>('0' + timestamp / 100 % 10);
+			state.output += static_cast<char>('0' + timestamp / 10 % 10);
+			state.output += static_cast<char>('0' + timestamp % 10);
+			state.output += ",\"pid\":" + std::to_string(GetTraceProcessId());
+			state.output += ",\"tid\":" + std::to_string(threadId);
+			state.output += record.type == TraceEventType::Instant ? ",\"s\":\"t\"}" : "}";
+		}
+		else
+		{
+			AppendTraceValue(state.output, static_cast<BYTE>(1 + static_cast<BYTE>(record.type)));
+			AppendTraceValue(state.output, name->second);
+			AppendTraceValue(state.output, threadId);
+			AppendTraceValue(state.output, timestamp);
+		}
+
+		++state.eventCount;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Writes the events of all the buffers, called by the flusher or by StopTrace once the flusher is done.
+	static void DrainTraceBuffers(TraceState& state)
+	{
+		// The buffers are written outside the lock, so the threads creating their buffer don't wait for the file.
+		{
+			std::lock_guard<std::mutex> lock{ state.buffersMutex };
+			state.drainedBuffers.clear();
+
+			for (const auto& pBuffer : state.buffers)
+			{
+				state.drainedBuffers.push_back(pBuffer.get());
+			}
+		}
+
+		for (auto pBuffer : state.drainedBuffers)
+		{
+			auto tail{ pBuffer->tail.load(std::memory_order_relaxed) };
+			auto head{ pBuffer->head.load(std::memory_order_acquire) };
+
+			for (; tail != head; ++tail)
+			{
+				WriteTraceRecord(state, pBuffer->threadId, pBuffer->records[tail % TRACE_BUFFER_CAPACITY]);
+
+				if (state.output.length() >= TRACE_OUTPUT_SIZE)
+				{
+					WriteTraceOutput(state);
+				}
+			}
+
+			pBuffer->tail.store(head, std::memory_order_release);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	static void RunTraceFlusher(TraceState& state)
+	{
+		std::unique_lock<std::mutex> lock{ state.flusherMutex };
+
+		while (!state.flusherWake.wait_for(lock, std::chrono::milliseconds{ 10 }, [&state] { return state.stop; }))
+		{
+			lock.unlock();
+			DrainTraceBuffers(state);
+			lock.lock();
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool StartTrace(LPCWSTR pFilePath, TraceFormat format)
+	{
+		auto& state{ GetTraceState() };
+		std::lock_guard<std::mutex> session{ state.sessionMutex };
+
+		if (state.hFile != nullptr)
+		{
+			return false;
+		}
+
+		auto hFile{ CreateTraceFile(pFilePath) };
+		if (hFile == nullptr)
+		{
+			return false;
+		}
+
+		// Events left by a previous trace are discarded.
+		{
+			std::lock_guard<std::mutex> lock{ state.buffersMutex };
+			for (const auto& pBuffer : state.buffers)
+			{
+				pBuffer->tail.store(pBuffer->head.load(std::memory_order_acquire), std::memory_order_release);
+			}
+		}
+
+		state.hFile = hFile;
+		state.format = format;
+		state.failed = false;
+		state.stop = false;
+		state.eventCount = 0;
+		state.output.clear();
+		state.nameIds.clear();
+		state.jsonNames.clear();
+		state.dropped.store(0, std::memory_order_relaxed);
+		state.startTimestamp = static_cast<UINT64>(TscClock::now().time_since_epoch().count());
+
+		if (format == TraceFormat::Json)
+		{
+			state.output += "{\"traceEvents\":[\n";
+		}
+		else
+		{
+			state.output += "HLPTRACE";
+			AppendTraceValue(state.output, UINT32{ 1 });
+		}
+
+		state.flusher = std::thread{ RunTraceFlusher, std::ref(state) };
+		GetTraceFlag().store(true, std::memory_order_release);
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Stops the flusher, writes the last events and closes the file of the trace being recorded.
+	// Returns : True if the trace has been written successfully.
+	static bool FinishTrace(TraceState& state)
+	{
+		GetTraceFlag().store(false, std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> lock{ state.flusherMutex };
+			state.stop = true;
+		}
+
+		state.flusherWake.notify_one();
+		state.flusher.join();
+
+		DrainTraceBuffers(state);
+
+		if (state.format == TraceFormat::Json)
+		{
+			state.output += "\n],\"displayTimeUnit\":\"ns\"}\n";
+		}
+
+		WriteTraceOutput(state);
+		state.failed = !CloseTraceFile(state.hFile) || state.failed;
+		state.hFile = nullptr;
+
+		return !state.failed;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	TraceState::~TraceState()
+	{
+		if (hFile != nullptr)
+		{
+			FinishTrace(*this);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool StopTrace()
+	{
+		auto& state{ GetTraceState() };
+		std::lock_guard<std::mutex> session{ state.sessionMutex };
+
+		return state.hFile != nullptr && FinishTrace(state);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	UINT64 GetTraceDroppedCount()
+	{
+		return GetTraceState().dropped.load(std::memory_order_relaxed);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,2405 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+// CppHelpers 1.5
+// Windows 7 and above
+//
+// MIT License
+//
+// Copyright(c) 2019 Philippe Coulombe
+// https://github.com/ebmoluoc/CppHelpers
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Part of CppHelpers that doesn't depend on the Windows API, it also builds with other compilers and platforms.
+// Outside of Windows, WCHAR is wchar_t and the wide strings hold UTF-32 where wchar_t has 32 bits.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <shlobj.h>
+#else
+#include <cstdint>
+#endif
+
+// The time stamp counter is read only on x86 processors, the TSC clocks use std::chrono::steady_clock elsewhere.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HLP_TSC
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(HLP_TSC)
+#include <x86intrin.h>
+#endif
+
+#ifndef _WIN32
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Windows types and constants used by the portable code.
+
+typedef unsigned char BYTE;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef char* LPSTR;
+typedef const char* LPCSTR;
+typedef WCHAR* LPWSTR;
+typedef const WCHAR* LPCWSTR;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef int BOOL;
+typedef int32_t LONG;
+typedef unsigned int UINT;
+typedef uint32_t DWORD;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef size_t SIZE_T;
+typedef uintptr_t WPARAM;
+typedef struct HWND__* HWND;
+
+struct POINT
+{
+	LONG x;
+	LONG y;
+};
+
+struct DROPFILES
+{
+	DWORD pFiles;
+	POINT pt;
+	BOOL fNC;
+	BOOL fWide;
+};
+
+#define FALSE					0
+#define TRUE					1
+#define MAX_PATH				260
+#define MAXDWORD				0xFFFFFFFF
+#define CP_ACP					0
+#define CP_UTF8					65001
+#define CF_UNICODETEXT			13
+#define CF_HDROP				15
+#define WM_RENDERFORMAT			0x0305
+#define WM_RENDERALLFORMATS		0x0306
+#define WM_DESTROYCLIPBOARD		0x0307
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace hlp
+{
+
+	class StringArena;
+	struct ParallelOptions;
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      clipboard
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Function writing the data of a clipboard format into its memory block (pointer to the block, size in bytes).
+	// It returns false to cancel the format.
+	using ClipboardWriter = std::function<bool(LPVOID, SIZE_T)>;
+
+	// Clipboard accessed by ClipboardTransaction.
+	class ClipboardBackend
+	{
+	public:
+		virtual ~ClipboardBackend() = default;
+		// hWndNewOwner : Window associated with the open clipboard or nullptr to be associated with the current process.
+		// Returns : True if the clipboard has been opened.
+		virtual bool Open(HWND hWndNewOwner) = 0;
+		// Returns : True if the content of the open clipboard has been emptied.
+		virtual bool Empty() = 0;
+		// uFormat : Format of clipboard data.
+		// nBytes : Size in bytes of the memory block given to the writer.
+		// writer : Function writing the data into the memory block.
+		// Returns : True if the data has been written and placed on the open clipboard.
+		virtual bool SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer) = 0;
+		// uFormat : Format of clipboard data rendered later by the clipboard owner (delayed rendering).
+		// Returns : True if the format has been placed on the open clipboard without its data.
+		virtual bool SetDelayedData(UINT uFormat) = 0;
+		// Close the open clipboard.
+		virtual void Close() = 0;
+		// hWnd : Window to be compared with the clipboard owner.
+		// Returns : True if the window owns the clipboard.
+		virtual bool IsOwner(HWND hWnd) = 0;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Clipboard kept in memory, used in place of the system clipboard to test or measure the code publishing the data.
+	class MemoryClipboardBackend : public ClipboardBackend
+	{
+	public:
+		MemoryClipboardBackend();
+		bool Open(HWND hWndNewOwner) override;
+		bool Empty() override;
+		bool SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer) override;
+		bool SetDelayedData(UINT uFormat) override;
+		void Close() override;
+		bool IsOwner(HWND hWnd) override;
+		// handler : Function receiving the clipboard messages as a window procedure would (window, message, wParam):
+		//           WM_RENDERFORMAT sent by RequestData (SetData is accepted while it runs even if the clipboard is not open)
+		//           and WM_DESTROYCLIPBOARD sent by Empty to the previous owner.
+		void SetMessageHandler(std::function<void(HWND, UINT, WPARAM)> handler);
+		// Simulates an application pasting a format: a delayed format is recorded as a render request and rendered first.
+		// uFormat : Format of clipboard data.
+		// Returns : Data of the format or nullptr if the format is not on the clipboard or has not been rendered.
+		const std::vector<BYTE>* RequestData(UINT uFormat);
+		// Returns : Formats for which a rendering has been requested, in order.
+		const std::vector<UINT>& GetRenderRequests() const;
+		// Returns : True if the clipboard is open.
+		bool IsOpen() const;
+		// Returns : Count of times the clipboard has been opened.
+		size_t GetOpenCount() const;
+		// Returns : Count of formats on the clipboard.
+		size_t GetFormatCount() const;
+		// uFormat : Format of clipboard data.
+		// Returns : Data of the format or nullptr if the format is not on the clipboard or has not been rendered.
+		const std::vector<BYTE>* GetData(UINT uFormat) const;
+	private:
+		std::vector<std::pair<UINT, std::vector<BYTE>>> formats_;
+		std::vector<UINT> delayedFormats_;
+		std::vector<UINT> renderRequests_;
+		std::function<void(HWND, UINT, WPARAM)> messageHandler_;
+		HWND hWndOpen_;
+		HWND hWndOwner_;
+		size_t openCount_;
+		bool open_;
+		bool owned_;
+		bool rendering_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Places one or more formats on the clipboard while it is opened only once. The clipboard is closed by Close
+	// or when the transaction is destroyed.
+	class ClipboardTransaction
+	{
+	public:
+		// backend : Clipboard used by the transaction, it must outlive the transaction.
+		explicit ClipboardTransaction(ClipboardBackend& backend);
+		~ClipboardTransaction();
+		// hWndNewOwner : Window associated with the open clipboard or nullptr to be associated with the current process.
+		// Returns : True if the clipboard has been opened and emptied.
+		bool Open(HWND hWndNewOwner);
+		// uFormat : Format of clipboard data.
+		// pData : Data to be copied to the clipboard.
+		// nBytes : Size in bytes of the data to be copied to the clipboard.
+		// Returns : True if successful.
+		bool SetData(UINT uFormat, LPCVOID pData, SIZE_T nBytes);
+		// uFormat : Format of clipboard data.
+		// nBytes : Size in bytes of the memory block given to the writer.
+		// writer : Function writing the data into the memory block of the clipboard (no intermediate copy).
+		// Returns : True if successful.
+		bool SetData(UINT uFormat, SIZE_T nBytes, const ClipboardWriter& writer);
+		// str : String to be copied to the clipboard (CF_UNICODETEXT).
+		// Returns : True if successful.
+		bool SetText(std::wstring_view str);
+		// uFormat : Format of clipboard data rendered later by the window given to Open (see DelayedClipboardProvider).
+		// Returns : True if successful.
+		bool SetDelayedData(UINT uFormat);
+		// Close the clipboard if it is open.
+		void Close();
+		// Returns : True if the clipboard is open.
+		bool IsOpen() const;
+	private:
+		ClipboardBackend& backend_;
+		bool open_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Function producing the data of a clipboard format when it is rendered.
+	using ClipboardProducer = std::function<std::vector<BYTE>()>;
+
+	// Places formats on the clipboard without their data, each format being produced only when an application
+	// requests it (delayed rendering). The window given to Publish must forward its clipboard messages to HandleMessage.
+	class DelayedClipboardProvider
+	{
+	public:
+		// backend : Clipboard used by the provider, it must outlive the provider.
+		explicit DelayedClipboardProvider(ClipboardBackend& backend);
+		// uFormat : Format of clipboard data (replaces the producer of a format already added).
+		// producer : Function producing the data of the format.
+		void AddFormat(UINT uFormat, ClipboardProducer producer);
+		// hWndOwner : Window that will own the clipboard and receive the rendering messages.
+		// Returns : True if the clipboard has been emptied and all the formats have been placed on it.
+		bool Publish(HWND hWndOwner);
+		// uFormat : Format requested by WM_RENDERFORMAT (the clipboard is already open).
+		// Returns : True if the format has been rendered.
+		bool RenderFormat(UINT uFormat);
+		// hWndOwner : Window that published the formats (WM_RENDERALLFORMATS, the clipboard is opened by the function).
+		// Returns : True if all the formats not rendered yet have been rendered or if the window no longer owns the clipboard.
+		bool RenderAllFormats(HWND hWndOwner);
+		// Releases the rendered data, called when the clipboard data is replaced (WM_DESTROYCLIPBOARD).
+		// The producers are kept so the formats can be published again.
+		void Clear();
+		// hWnd : Window receiving the message.
+		// uMsg : Message.
+		// wParam : Additional message information.
+		// Returns : True if the message has been handled (the window procedure then returns 0).
+		bool HandleMessage(HWND hWnd, UINT uMsg, WPARAM wParam);
+		// Returns : Size in bytes of the rendered data kept in the cache.
+		size_t GetCacheSize() const;
+	private:
+		struct Format
+		{
+			UINT format;
+			ClipboardProducer producer;
+			std::optional<std::vector<BYTE>> data;
+			bool rendered;
+		};
+		ClipboardBackend& backend_;
+		std::vector<Format> formats_;
+		bool publishing_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      CodeTiming
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Simple class for code timing, Clock is std::chrono::steady_clock (CodeTiming) or TscClock / TscpClock.
+	template <typename Clock>
+	class BasicCodeTiming
+	{
+	public:
+		void Start() { start_ = Clock::now(); }
+		void Stop() { stop_ = Clock::now(); }
+		template <typename T>
+		std::wstring Result() const { return std::to_wstring(ResultCount<T>()); }
+		template <typename T>
+		typename T::rep ResultCount() const { return std::chrono::duration_cast<T>(stop_ - start_).count(); }
+	private:
+		typename Clock::time_point start_;
+		typename Clock::time_point stop_;
+	};
+
+	using CodeTiming = BasicCodeTiming<std::chrono::steady_clock>;
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Frequency of the time stamp counter measured against std::chrono::steady_clock.
+	struct TscCalibration
+	{
+		// True if the processor has an invariant time stamp counter (constant rate, not stopped in sleep states).
+		bool invariant;
+		double nanosecondsPerTick;
+		// Counter value at the calibration. The clocks count the ticks from it, so converted to double they keep their
+		// precision (the counter itself exceeds 2^53 after about a month of uptime at 3 GHz).
+		unsigned long long baseTicks;
+	};
+
+	// Returns : Frequency of the time stamp counter measured now (takes about 10 ms).
+	TscCalibration CalibrateTsc();
+
+	// Returns : Calibration measured by the first call, so only the programs using the clocks pay for it.
+	inline const TscCalibration& GetTscCalibration()
+	{
+		static const TscCalibration calibration{ CalibrateTsc() };
+		return calibration;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Clock reading the time stamp counter (rdtsc, or rdtscp waiting for the previous instructions when Serializing
+	// is true), or std::chrono::steady_clock if the counter is not invariant or the processor is not x86.
+	template <bool Serializing>
+	class BasicTscClock
+	{
+	public:
+		using rep = long long;
+		using period = std::nano;
+		using duration = std::chrono::nanoseconds;
+		using time_point = std::chrono::time_point<BasicTscClock>;
+		static constexpr bool is_steady{ true };
+
+		static time_point now() noexcept
+		{
+#ifdef HLP_TSC
+			const auto& calibration{ GetTscCalibration() };
+
+			if (calibration.invariant)
+			{
+				unsigned long long ticks;
+				if constexpr (Serializing)
+				{
+					unsigned int aux;
+					ticks = __rdtscp(&aux);
+				}
+				else
+				{
+					ticks = __rdtsc();
+				}
+
+				// The counter of another core can be slightly behind the base, hence the signed difference.
+				return time_point{ duration{ static_cast<rep>(static_cast<long long>(ticks - calibration.baseTicks) * calibration.nanosecondsPerTick) } };
+			}
+#endif
+
+			return time_point{ std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()) };
+		}
+	};
+
+	using TscClock = BasicTscClock<false>;
+	using TscpClock = BasicTscClock<true>;
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Maximum count of probes, the probes created beyond it are ignored.
+	constexpr size_t MAX_PROFILER_PROBES{ 256 };
+
+	// Named point of measure of the profiler, declared as a function-local static so it is registered once:
+	//     static hlp::ProfilerProbe probe{ L"LoadImage" };
+	//     hlp::ProfilerScope scope{ probe };
+	// The durations are recorded in per-thread histograms (about 1.6% of precision, up to about 18 minutes),
+	// merged into a single histogram per probe when their thread exits.
+	class ProfilerProbe
+	{
+	public:
+		// pName : Name of the probe, it must outlive the probe (a string literal).
+		explicit ProfilerProbe(LPCWSTR pName);
+		// duration : Duration to be recorded in the histogram of the calling thread.
+		void Record(std::chrono::nanoseconds duration) const;
+		// Returns : Name of the probe.
+		LPCWSTR GetName() const;
+	private:
+		LPCWSTR pName_;
+		size_t id_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns : Flag set while the scopes record their durations (set by default).
+	inline std::atomic<bool>& GetProfilerFlag()
+	{
+		static std::atomic<bool> enabled{ true };
+		return enabled;
+	}
+
+	// enabled : True to record the durations of the scopes, false to reduce a scope to a flag test.
+	inline void SetProfilerEnabled(bool enabled)
+	{
+		GetProfilerFlag().store(enabled, std::memory_order_relaxed);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Records in a probe the time elapsed between its construction and its destruction, only a flag test if the
+	// profiler is disabled.
+	class ProfilerScope
+	{
+	public:
+		explicit ProfilerScope(const ProfilerProbe& probe) :
+			pProbe_{ GetProfilerFlag().load(std::memory_order_relaxed) ? &probe : nullptr }, start_{}
+		{
+			if (pProbe_ != nullptr)
+			{
+				start_ = TscClock::now();
+			}
+		}
+		~ProfilerScope()
+		{
+			if (pProbe_ != nullptr)
+			{
+				pProbe_->Record(TscClock::now() - start_);
+			}
+		}
+	private:
+		const ProfilerProbe* pProbe_;
+		TscClock::time_point start_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Durations recorded by a probe in all the threads, in nanoseconds.
+	struct ProfilerStats
+	{
+		LPCWSTR pName;
+		UINT64 count;
+		UINT64 mean;
+		UINT64 p50;
+		UINT64 p99;
+		UINT64 p999;
+		UINT64 max;
+	};
+
+	// Returns : Statistics of the probes that have recorded at least one duration, in registration order.
+	std::vector<ProfilerStats> GetProfilerStats();
+
+	// Returns : One line per probe with its count, mean, p50, p99, p999 and max.
+	std::wstring GetProfilerReport();
+
+	// Clears the recorded durations (the durations recorded at the same time by other threads may be lost).
+	void ResetProfiler();
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      com
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0" (shorter than 4G characters).
+	// offsets : Receives the offset in characters of each item followed by the offset of the final null terminator.
+	// Returns : Length of the sequence including the null terminator.
+	size_t GetMultiSzOffsets(LPCSTR pMultiSz, std::vector<UINT32>& offsets);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0" (shorter than 4G characters).
+	// offsets : Receives the offset in characters of each item followed by the offset of the final null terminator.
+	// Returns : Length of the sequence including the null terminator.
+	size_t GetMultiSzOffsets(LPCWSTR pMultiSz, std::vector<UINT32>& offsets);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Offset table of a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0" (CHAR or WCHAR).
+	// The sequence is scanned once by Load (GetMultiSzOffsets), then the items are accessed randomly without rescanning it.
+	// It is declared with the com classes because DropFilesList holds one.
+	template <typename T>
+	class MultiSzIndex
+	{
+	public:
+		MultiSzIndex() : pMultiSz_{ nullptr }, length_{ 0 } {}
+		// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings (can be null).
+		explicit MultiSzIndex(const T* pMultiSz) { Load(pMultiSz); }
+		// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings (can be null). The sequence must outlive the index.
+		void Load(const T* pMultiSz)
+		{
+			pMultiSz_ = pMultiSz;
+			offsets_.clear();
+			length_ = pMultiSz != nullptr ? GetMultiSzOffsets(pMultiSz, offsets_) : 0;
+		}
+		// Returns : Count of null-terminated strings in the sequence.
+		size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+		// Returns : True if the sequence is null or points to a null terminator.
+		bool empty() const { return size() == 0; }
+		// index : Index of the item (must be lower than size()).
+		// Returns : View of the item in the sequence.
+		std::basic_string_view<T> operator[](size_t index) const { return std::basic_string_view<T>{ pMultiSz_ + offsets_[index], size_t{ offsets_[index + 1] - offsets_[index] - 1 } }; }
+		// Returns : Size in bytes of the sequence including the null terminator or 0 if the sequence is null.
+		size_t ByteSize() const { return length_ * sizeof(T); }
+		// Returns : True if the sequence has more than one item.
+		bool IsMultiItems() const { return size() > 1; }
+		// Returns : Pointer to the sequence (null if nothing is loaded).
+		const T* data() const { return pMultiSz_; }
+	private:
+		const T* pMultiSz_;
+		size_t length_;
+		// Offsets of the items followed by the offset of the final terminator (32 bits halve the table of large lists).
+		std::vector<UINT32> offsets_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Class for reading a DROPFILES structure from a memory block (see DataObjectDropFilesList for a data object).
+	class DropFilesList
+	{
+	public:
+		DropFilesList();
+		virtual ~DropFilesList();
+		// pData : Pointer to a DROPFILES structure followed by its list of files (CF_HDROP memory block). It must outlive the list.
+		// nBytes : Size in bytes of the memory block (the list must be terminated within the block).
+		// Returns : True if the DROPFILES structure has been loaded successfully.
+		bool Load(LPCVOID pData, SIZE_T nBytes);
+		// Free the resources (doesn't need to be called before Load).
+		virtual void Unload();
+		// Returns : True if the list has more than 1 item or false otherise (including no data loaded).
+		bool IsMultiItems() const;
+		// Returns : First item in the list or an empty string if there is no data loaded.
+		std::wstring GetFirstItem() const;
+		// Returns : All the items in the list or an empty container if there is no data loaded.
+		std::vector<std::wstring> GetItems() const;
+		// items : Storage to which all the items in the list are appended (nothing is appended if there is no data loaded).
+		void GetItems(StringArena& items) const;
+		// Returns : Count of items in the list (the list is scanned once on the first call of Count or GetItem).
+		size_t Count() const;
+		// index : Index of the item (must be lower than Count()).
+		// Returns : Item at the index.
+		std::wstring GetItem(size_t index) const;
+		// callback : Function called with each item in the list (std::wstring_view valid during the call only), nothing is stored.
+		template <typename Callback>
+		void ForEach(Callback callback) const;
+		// transform : Function called concurrently by worker threads with each item (std::wstring_view valid during the call only) and returning its result.
+		// consume : Function called on the calling thread with the index and the result of each item, in the list order.
+		// options : Count of threads, back-pressure and cancellation (ParallelOptions{} for the defaults).
+		// Returns : True if all the items have been consumed or false if cancelled (see ParallelForEachOrdered).
+		template <typename Transform, typename Consume>
+		bool ParallelForEach(Transform transform, Consume consume, const ParallelOptions& options) const;
+	protected:
+		// Pointer to a sequence of null-terminated strings, terminated by a null character "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+		LPCWSTR pList_;
+		// If fWide_ is not true, pList_ must be cast as LPCSTR to be usable.
+		bool fWide_;
+		// pData : Pointer to a DROPFILES memory block.
+		// nBytes : Size in bytes of the memory block.
+		// Returns : True if the block is valid and pList_ and fWide_ have been set.
+		bool Attach(LPCVOID pData, SIZE_T nBytes);
+	private:
+		// Load the index of the list if not done yet.
+		void BuildIndex() const;
+		// item : Item of a narrow list.
+		// buffer : String receiving the item converted to wide characters (its storage is reused).
+		static void ConvertItem(std::string_view item, std::wstring& buffer);
+		// Index of a wide list (not loaded if the list is narrow or if it's not built yet).
+		mutable MultiSzIndex<WCHAR> wideIndex_;
+		// Index of a narrow list (not loaded if the list is wide or if it's not built yet).
+		mutable MultiSzIndex<CHAR> narrowIndex_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      environment
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// argument : Argument to be escaped.
+	// Returns : String containing the escaped argument.
+	std::wstring EscapeArgument(std::wstring argument);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// argument : Argument to be escaped.
+	// pBuffer : Buffer receiving the escaped argument (GetEscapedArgumentLength characters, no null terminator added).
+	// Returns : Pointer past the last character written.
+	LPWSTR EscapeArgument(std::wstring_view argument, LPWSTR pBuffer);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// argument : Argument to be escaped.
+	// Returns : Length of the argument once escaped by EscapeArgument.
+	size_t GetEscapedArgumentLength(std::wstring_view argument);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Builder of a command line made of arguments escaped by EscapeArgument and separated by a space.
+	// The arguments can be any range of std::wstring, std::wstring_view or LPCWSTR.
+	template <typename Range>
+	class CommandLineBuilder
+	{
+	public:
+		// arguments : Arguments of the command line. The range must outlive the builder.
+		explicit CommandLineBuilder(const Range& arguments) : arguments_{ arguments }, length_{ 0 }
+		{
+			for (const auto& argument : arguments_)
+			{
+				length_ += GetEscapedArgumentLength(argument) + 1;
+			}
+
+			if (length_ != 0)
+			{
+				--length_;
+			}
+		}
+		// Returns : Length of the command line in characters (without the null terminator).
+		size_t Length() const { return length_; }
+		// pBuffer : Buffer receiving the null-terminated command line (can be passed to CreateProcess).
+		// length : Length of the buffer in characters.
+		// Returns : True if successful or false if the buffer is too small.
+		bool Write(LPWSTR pBuffer, size_t length) const
+		{
+			if (length <= length_)
+			{
+				return false;
+			}
+
+			auto pFirst{ pBuffer };
+			for (const auto& argument : arguments_)
+			{
+				if (pBuffer != pFirst)
+				{
+					*pBuffer++ = L' ';
+				}
+
+				pBuffer = EscapeArgument(argument, pBuffer);
+			}
+
+			*pBuffer = L'\0';
+			return true;
+		}
+		// commandLine : String to which the command line is appended (resized once).
+		void AppendTo(std::wstring& commandLine) const
+		{
+			auto offset{ commandLine.length() };
+			commandLine.resize(offset + length_);
+			Write(&commandLine[offset], length_ + 1);
+		}
+		// Returns : String containing the command line.
+		std::wstring Build() const
+		{
+			std::wstring commandLine{};
+			AppendTo(commandLine);
+			return commandLine;
+		}
+	private:
+		const Range& arguments_;
+		size_t length_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Class for splitting a command line into arguments following the Microsoft C/C++ parsing rules (inverse of EscapeArgument).
+	// The program name is parsed with the same rules as the other arguments.
+	class CommandLineArguments
+	{
+	public:
+		CommandLineArguments();
+		// commandLine : Command line to be parsed. It must outlive the object since the arguments may point into it.
+		void Load(std::wstring_view commandLine);
+		// Returns : Count of arguments.
+		size_t size() const { return arguments_.size(); }
+		// Returns : True if there is no arguments.
+		bool empty() const { return arguments_.empty(); }
+		// index : Index of the argument (must be lower than size()).
+		// Returns : View of the argument, in the command line if it needed no unescaping or in the internal buffer otherwise.
+		std::wstring_view operator[](size_t index) const { return arguments_[index]; }
+		std::vector<std::wstring_view>::const_iterator begin() const { return arguments_.begin(); }
+		std::vector<std::wstring_view>::const_iterator end() const { return arguments_.end(); }
+	private:
+		std::vector<std::wstring_view> arguments_;
+		std::unique_ptr<WCHAR[]> buffer_;
+		size_t bufferLength_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      path
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Splitting of a backslash path into views (nothing is copied or allocated, the path must outlive the object).
+	// The root can be a drive "c:\\", a UNC share "\\\\server\\share\\", a prefixed path "\\\\?\\c:\\", "\\\\?\\UNC\\server\\share\\",
+	// a volume "\\\\?\\Volume{GUID}\\" or device "\\\\.\\name\\", the current drive root "\\" or a relative drive "c:".
+	class PathView
+	{
+	public:
+		// Iterator over the components of the path after the root (the empty components are skipped).
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::wstring_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+			Iterator() : item_{}, rest_{} {}
+			explicit Iterator(std::wstring_view rest);
+			reference operator*() const { return item_; }
+			pointer operator->() const { return &item_; }
+			Iterator& operator++() { *this = Iterator{ rest_ }; return *this; }
+			Iterator operator++(int) { auto it{ *this }; ++*this; return it; }
+			bool operator==(const Iterator& other) const { return item_.data() == other.item_.data(); }
+			bool operator!=(const Iterator& other) const { return item_.data() != other.item_.data(); }
+		private:
+			value_type item_;
+			value_type rest_;
+		};
+		// path : Path to be parsed.
+		explicit PathView(std::wstring_view path);
+		// Returns : Whole path.
+		std::wstring_view Path() const { return path_; }
+		// Returns : Root of the path including its backslash if any ("c:\\", "\\\\server\\share\\"...) or an empty view for a relative path.
+		std::wstring_view Root() const { return path_.substr(0, rootLength_); }
+		// Returns : Path without its last component and the backslashes before it, the root is kept ("c:\\dir\\file" gives "c:\\dir", "c:\\dir" gives "c:\\").
+		std::wstring_view Parent() const;
+		// Returns : Last component of the path or an empty view if the path ends with a backslash or is only a root.
+		std::wstring_view FileName() const { return path_.substr(nameOffset_); }
+		// Returns : File name without its extension.
+		std::wstring_view Stem() const { auto fileName{ FileName() }; return fileName.substr(0, fileName.length() - Extension().length()); }
+		// Returns : Extension of the file name including the dot or an empty view if it has none (".gitignore", "." and ".." have no extension).
+		std::wstring_view Extension() const;
+		Iterator begin() const { return Iterator{ path_.substr(rootLength_) }; }
+		Iterator end() const { return Iterator{}; }
+	private:
+		std::wstring_view path_;
+		size_t rootLength_;
+		size_t nameOffset_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Builder of a path made of parts joined by a backslash, which isn't added after a part ending with one. The empty parts
+	// are skipped and the leading backslashes of the parts after the first are removed, the other backslashes are kept as they are.
+	// The parts can be std::wstring, std::wstring_view or LPCWSTR.
+	template <size_t N>
+	class PathBuilder
+	{
+	public:
+		// parts : Parts of the path. They must outlive the builder.
+		template <typename... Parts>
+		explicit PathBuilder(const Parts&... parts) : parts_{ std::wstring_view{ parts }... }, length_{ Join(nullptr) } {}
+		// Returns : Length of the path in characters (without the null terminator).
+		size_t Length() const { return length_; }
+		// pBuffer : Buffer receiving the null-terminated path.
+		// length : Length of the buffer in characters.
+		// Returns : True if successful or false if the buffer is too small.
+		bool Write(LPWSTR pBuffer, size_t length) const
+		{
+			if (length <= length_)
+			{
+				return false;
+			}
+
+			pBuffer[Join(pBuffer)] = L'\0';
+			return true;
+		}
+		// path : String to which the path is appended (resized once).
+		void AppendTo(std::wstring& path) const
+		{
+			auto offset{ path.length() };
+			path.resize(offset + length_);
+			Write(&path[offset], length_ + 1);
+		}
+		// Returns : String containing the path.
+		std::wstring Build() const
+		{
+			std::wstring path{};
+			AppendTo(path);
+			return path;
+		}
+	private:
+		// pBuffer : Buffer receiving the path (not null-terminated) or nullptr to only compute its length.
+		// Returns : Length of the path in characters.
+		size_t Join(LPWSTR pBuffer) const
+		{
+			size_t length{ 0 };
+			auto separated{ true };
+
+			for (auto part : parts_)
+			{
+				if (length != 0)
+				{
+					part.remove_prefix((std::min)(part.find_first_not_of(L'\\'), part.length()));
+				}
+
+				if (part.empty())
+				{
+					continue;
+				}
+
+				if (!separated)
+				{
+					if (pBuffer != nullptr)
+					{
+						pBuffer[length] = L'\\';
+					}
+
+					++length;
+				}
+
+				if (pBuffer != nullptr)
+				{
+					part.copy(pBuffer + length, part.length());
+				}
+
+				length += part.length();
+				separated = part.back() == L'\\';
+			}
+
+			return length;
+		}
+		std::array<std::wstring_view, N> parts_;
+		size_t length_;
+	};
+
+	template <typename... Parts>
+	PathBuilder(const Parts&...)->PathBuilder<sizeof...(Parts)>;
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Handling of the "\\\\?\\" prefix by NormalizePath.
+	enum class LongPathPrefix
+	{
+		Keep,   // The prefix is left as it is.
+		Add,    // The prefix is added to an absolute path of MAX_PATH characters or more ("\\\\?\\c:\\..." or "\\\\?\\UNC\\server\\...").
+		Remove  // The prefix is removed from a drive or UNC path if it is shorter than MAX_PATH characters without it.
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pPath : Path to be normalized in place (slashes become backslashes, repeated separators and "." are removed, ".." removes the previous component).
+	//         The root is kept, ".." can't go above it, and a trailing separator is kept. A relative path that becomes empty is ".".
+	// length : Length of the path in characters.
+	// Returns : Length of the normalized path (never longer than the original path, no null terminator added).
+	size_t NormalizePath(LPWSTR pPath, size_t length);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// path : Path to be normalized (see NormalizePath above, the string is reused when moved in).
+	// prefix : Handling of the "\\\\?\\" prefix for long paths.
+	// Returns : Normalized path.
+	std::wstring NormalizePath(std::wstring path, LongPathPrefix prefix = LongPathPrefix::Keep);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// fullPath : Full path of a file or directory.
+	// newName : New name of the last path item (after the last backslash).
+	// Returns : String containing the renamed path (doesn't rename the actual item on disk if it exists).
+	std::wstring RenamePath(const std::wstring& fullPath, const std::wstring& newName);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// fullPath : Full path of a file or directory.
+	// newName : New name of the last path item (after the last backslash).
+	// pResource : Memory resource used for the returned string.
+	// Returns : String containing the renamed path (doesn't rename the actual item on disk if it exists).
+	std::pmr::wstring RenamePath(std::wstring_view fullPath, std::wstring_view newName, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Trie of paths where each directory is stored once, built from a DropFilesList or a multi-sz sequence for instance.
+	// The paths are split like PathView (the root is the first component) and the components are compared ordinally,
+	// so the paths should be normalized the same way (NormalizePath) and have the same case to be matched.
+	class PathTree
+	{
+	public:
+		// Identifier of a node (a root, a directory or an item).
+		using NodeId = UINT;
+		// Invalid node (nothing found or no more children).
+		static constexpr NodeId NO_NODE{ 0xFFFFFFFF };
+		// Node at the top of the tree (without name) whose children are the roots of the paths.
+		static constexpr NodeId TOP_NODE{ 0 };
+		PathTree();
+		~PathTree();
+		// path : Path of the item to be added.
+		// Returns : True if the item has been added or false if it was already in the tree (or the path is empty).
+		bool Add(std::wstring_view path);
+		// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0" (can be null).
+		// Returns : Count of items added (the duplicates are not counted).
+		size_t Load(LPCWSTR pMultiSz);
+		// dropFiles : List of items to be added.
+		// Returns : Count of items added (the duplicates are not counted).
+		size_t Load(const DropFilesList& dropFiles);
+		// Free all the nodes.
+		void Clear();
+		// path : Path to be found.
+		// Returns : True if the path has been added as an item (not only as the directory of other items).
+		bool Contains(std::wstring_view path) const;
+		// path : Path of an item or a directory to be found.
+		// Returns : Node of the path or NO_NODE if it is not in the tree.
+		NodeId Find(std::wstring_view path) const;
+		// node : Node of the tree.
+		// Returns : Parent of the node or NO_NODE for TOP_NODE.
+		NodeId GetParent(NodeId node) const { return nodes_[node].parent; }
+		// node : Node of the tree.
+		// Returns : First child of the node (in the order they were added) or NO_NODE if it has none.
+		NodeId GetFirstChild(NodeId node) const { return nodes_[node].firstChild; }
+		// node : Node of the tree.
+		// Returns : Next child of the same parent or NO_NODE if it is the last one.
+		NodeId GetNextSibling(NodeId node) const { return nodes_[node].nextSibling; }
+		// node : Node of the tree.
+		// Returns : True if the node has been added as an item.
+		bool IsItem(NodeId node) const { return nodes_[node].item; }
+		// node : Node of the tree.
+		// Returns : Name of the node (a root keeps its backslash "c:\\").
+		std::wstring_view GetName(NodeId node) const;
+		// node : Node of the tree.
+		// path : String receiving the full path of the node (the previous content is replaced).
+		void GetPath(NodeId node, std::wstring& path) const;
+		// Returns : Count of items.
+		size_t size() const { return itemCount_; }
+		// Returns : Count of nodes (the roots, directories and items stored once each).
+		size_t GetNodeCount() const { return nodes_.size(); }
+		// Returns : Approximate size in bytes of the memory used by the tree.
+		size_t GetMemoryUsage() const;
+		// prefix : Path of a directory or an item (all the items if empty).
+		// callback : Function called with the full path (std::wstring_view) of each item under the prefix, including the prefix itself if it is an item.
+		template <typename Callback>
+		void ForEachItem(std::wstring_view prefix, Callback callback) const
+		{
+			auto start{ prefix.empty() ? TOP_NODE : Find(prefix) };
+			if (start == NO_NODE)
+			{
+				return;
+			}
+
+			std::wstring path{};
+			GetPath(start, path);
+			std::vector<size_t> lengths{};
+
+			for (auto node{ start };;)
+			{
+				if (nodes_[node].item)
+				{
+					callback(std::wstring_view{ path });
+				}
+
+				if (nodes_[node].firstChild != NO_NODE)
+				{
+					lengths.push_back(path.length());
+					node = nodes_[node].firstChild;
+					AppendName(node, path);
+					continue;
+				}
+
+				while (node != start && nodes_[node].nextSibling == NO_NODE)
+				{
+					node = nodes_[node].parent;
+					path.resize(lengths.back());
+					lengths.pop_back();
+				}
+
+				if (node == start)
+				{
+					return;
+				}
+
+				node = nodes_[node].nextSibling;
+				path.resize(lengths.back());
+				AppendName(node, path);
+			}
+		}
+		// callback : Function called for each directory containing items with its full path (std::wstring_view) and
+		//            the names of its items (const std::vector<std::wstring_view>&), in the order the directories were added.
+		template <typename Callback>
+		void ForEachDirectory(Callback callback) const
+		{
+			std::wstring path{};
+			std::vector<std::wstring_view> names{};
+
+			for (NodeId node{ 0 }; node < nodes_.size(); ++node)
+			{
+				names.clear();
+
+				for (auto child{ nodes_[node].firstChild }; child != NO_NODE; child = nodes_[child].nextSibling)
+				{
+					if (nodes_[child].item)
+					{
+						names.push_back(GetName(child));
+					}
+				}
+
+				if (!names.empty())
+				{
+					GetPath(node, path);
+					callback(std::wstring_view{ path }, names);
+				}
+			}
+		}
+	private:
+		struct Node
+		{
+			UINT name;
+			UINT hash;
+			NodeId parent;
+			NodeId firstChild;
+			NodeId lastChild;
+			NodeId nextSibling;
+			bool item;
+		};
+		// node : Node whose name is appended.
+		// path : Path of the parent of the node.
+		void AppendName(NodeId node, std::wstring& path) const;
+		// parent : Parent of the child.
+		// name : Name of the child.
+		// hash : Hash of the parent and name.
+		// Returns : Slot of the child in slots_ or the empty slot where it would be inserted.
+		size_t FindSlot(NodeId parent, std::wstring_view name, UINT hash) const;
+		// parent : Parent of the child.
+		// name : Name of the child.
+		// Returns : Child node found or added.
+		NodeId AddChild(NodeId parent, std::wstring_view name);
+		std::vector<Node> nodes_;
+		// Open addressing hash table of the nodes by parent and name.
+		std::vector<NodeId> slots_;
+		std::unique_ptr<StringArena> pNames_;
+		// Directory of the last item added and its node.
+		std::wstring lastParent_;
+		NodeId lastParentNode_;
+		size_t itemCount_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      string
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Output iterator discarding everything written to it (used to measure what a writer produces).
+	class DiscardIterator
+	{
+	public:
+		using iterator_category = std::output_iterator_tag;
+		using value_type = void;
+		using difference_type = ptrdiff_t;
+		using pointer = void;
+		using reference = void;
+		DiscardIterator& operator*() { return *this; }
+		DiscardIterator& operator++() { return *this; }
+		DiscardIterator operator++(int) { return *this; }
+		DiscardIterator& operator=(WCHAR) { return *this; }
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// writer : Callable taking an output iterator (auto&&), writing the string to it with the ...To functions and returning the count of characters written.
+	//          It is called twice, first to measure the string and then to write it, so it must produce the same output both times.
+	// Returns : String written by the writer (allocated once at its exact length).
+	template <typename Writer>
+	std::wstring BuildString(Writer writer)
+	{
+		std::wstring result(writer(DiscardIterator{}), L'\0');
+		auto pBuffer{ &result[0] };
+		writer(pBuffer);
+		return result;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// writer : Callable taking an output iterator (auto&&), see BuildString above.
+	// pResource : Memory resource used for the returned string.
+	// Returns : String written by the writer (allocated once at its exact length).
+	template <typename Writer>
+	std::pmr::wstring BuildString(Writer writer, std::pmr::memory_resource* pResource)
+	{
+		std::pmr::wstring result(writer(DiscardIterator{}), L'\0', pResource);
+		auto pBuffer{ &result[0] };
+		writer(pBuffer);
+		return result;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Fixed capacity string usable in constant expressions (N includes the null terminator).
+	template <size_t N>
+	class StaticString
+	{
+	public:
+		constexpr StaticString() : data_{}, length_{ 0 } {}
+		// chr : Character to be appended (the capacity must not be exceeded).
+		constexpr void Append(WCHAR chr) { data_[length_++] = chr; }
+		// pStr : Characters to be appended (null characters included).
+		// length : Count of characters to be appended.
+		constexpr void Append(LPCWSTR pStr, size_t length) { for (size_t i{ 0 }; i < length; ++i) { Append(pStr[i]); } }
+		constexpr LPCWSTR c_str() const { return data_; }
+		constexpr size_t length() const { return length_; }
+		// Returns : Size in bytes of the string including the null terminator.
+		constexpr size_t ByteSize() const { return (length_ + 1) * sizeof(WCHAR); }
+		constexpr std::wstring_view view() const { return std::wstring_view{ data_, length_ }; }
+	private:
+		WCHAR data_[N];
+		size_t length_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be processed.
+	// Returns : String where all the backslashes are escaped (doubled).
+	std::wstring EscapeBackslash(std::wstring str);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be processed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : String where all the backslashes are escaped (doubled).
+	std::pmr::wstring EscapeBackslash(std::wstring_view str, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be processed.
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written (the string where all the backslashes are escaped).
+	template <typename OutputIt>
+	size_t EscapeBackslashTo(std::wstring_view str, OutputIt&& out)
+	{
+		size_t count{ 0 };
+
+		for (size_t pos{ 0 };;)
+		{
+			auto next{ str.find(L'\\', pos) };
+			auto run{ str.substr(pos, next == std::wstring_view::npos ? next : next + 1 - pos) };
+			out = std::copy(run.begin(), run.end(), out);
+			count += run.length();
+
+			if (next == std::wstring_view::npos)
+			{
+				return count;
+			}
+
+			*out++ = L'\\';
+			++count;
+			pos = next + 1;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be processed.
+	// Returns : Length of the string once all the backslashes are escaped (doubled).
+	constexpr size_t GetEscapedBackslashLength(std::wstring_view str)
+	{
+		auto length{ str.length() };
+
+		for (auto chr : str)
+		{
+			if (chr == L'\\')
+			{
+				++length;
+			}
+		}
+
+		return length;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String literal to be processed.
+	// Returns : String where all the backslashes are escaped (doubled), computed at compile time in a constexpr context.
+	template <size_t N>
+	constexpr StaticString<2 * N - 1> StaticEscapeBackslash(const WCHAR(&str)[N])
+	{
+		StaticString<2 * N - 1> escaped{};
+
+		for (size_t i{ 0 }; i + 1 < N; ++i)
+		{
+			escaped.Append(str[i]);
+
+			if (str[i] == L'\\')
+			{
+				escaped.Append(L'\\');
+			}
+		}
+
+		return escaped;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// Returns : Length of the strings joined together and separated by the specified separator.
+	template <typename Range>
+	size_t GetJoinedLength(const Range& strings, std::wstring_view separator)
+	{
+		size_t length{ 0 };
+		size_t count{ 0 };
+
+		for (const auto& str : strings)
+		{
+			length += std::wstring_view{ str }.length();
+			++count;
+		}
+
+		return count != 0 ? length + (count - 1) * separator.length() : 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// pBuffer : Buffer receiving the joined strings (GetJoinedLength characters, no null terminator added).
+	// Returns : Pointer past the last character written.
+	template <typename Range>
+	LPWSTR JoinStrings(const Range& strings, std::wstring_view separator, LPWSTR pBuffer)
+	{
+		auto first{ true };
+
+		for (const auto& str : strings)
+		{
+			if (!first)
+			{
+				pBuffer += separator.copy(pBuffer, separator.length());
+			}
+
+			std::wstring_view view{ str };
+			pBuffer += view.copy(pBuffer, view.length());
+			first = false;
+		}
+
+		return pBuffer;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// result : String to which the joined strings are appended (resized once to the exact length).
+	template <typename Range>
+	void JoinStrings(const Range& strings, std::wstring_view separator, std::wstring& result)
+	{
+		auto offset{ result.length() };
+		result.resize(offset + GetJoinedLength(strings, separator));
+		JoinStrings(strings, separator, &result[offset]);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// Returns : String made of all the strings joined together and separated by the specified separator.
+	template <typename Range>
+	std::wstring JoinStrings(const Range& strings, std::wstring_view separator)
+	{
+		std::wstring result{};
+		JoinStrings(strings, separator, result);
+		return result;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// pResource : Memory resource used for the returned string.
+	// Returns : String made of all the strings joined together and separated by the specified separator.
+	template <typename Range>
+	std::pmr::wstring JoinStrings(const Range& strings, std::wstring_view separator, std::pmr::memory_resource* pResource)
+	{
+		std::pmr::wstring result(GetJoinedLength(strings, separator), L'\0', pResource);
+		JoinStrings(strings, separator, &result[0]);
+		return result;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// writer : Callable writing an item (std::wstring_view, auto& out) and returning the count of characters written.
+	// Returns : Count of characters written.
+	template <typename Range, typename OutputIt, typename Writer>
+	size_t JoinStringsTo(const Range& strings, std::wstring_view separator, OutputIt&& out, Writer writer)
+	{
+		size_t count{ 0 };
+		auto first{ true };
+
+		for (const auto& str : strings)
+		{
+			if (!first)
+			{
+				out = std::copy(separator.begin(), separator.end(), out);
+				count += separator.length();
+			}
+
+			count += writer(std::wstring_view{ str }, out);
+			first = false;
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined (any range of std::wstring, std::wstring_view or LPCWSTR).
+	// separator : String used as separator.
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written.
+	template <typename Range, typename OutputIt>
+	size_t JoinStringsTo(const Range& strings, std::wstring_view separator, OutputIt&& out)
+	{
+		return JoinStringsTo(strings, separator, out, [](std::wstring_view str, auto& itemOut)
+		{
+			itemOut = std::copy(str.begin(), str.end(), itemOut);
+			return str.length();
+		});
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// strings : Strings to be joined.
+	// separator : String used as separator.
+	// avgLength : Unused, the exact length is computed (kept for compatibility).
+	// Returns : String made of all the strings joined together and separated by the specified separator.
+	std::wstring JoinStrings(const std::vector<std::wstring>& strings, const std::wstring& separator, size_t avgLength);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : True if the sequence has more than one item.
+	bool IsMultiSzItems(LPCSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : True if the sequence has more than one item.
+	bool IsMultiSzItems(LPCWSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : Count of null-terminated strings in the sequence.
+	size_t GetMultiSzCount(LPCSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : Count of null-terminated strings in the sequence.
+	size_t GetMultiSzCount(LPCWSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// multiSz : Sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0" (the final null terminator is optional).
+	// Returns : Count of null-terminated strings in the sequence (an empty string ends it).
+	constexpr size_t GetMultiSzCount(std::wstring_view multiSz)
+	{
+		size_t count{ 0 };
+		size_t pos{ 0 };
+
+		while (pos < multiSz.length() && multiSz[pos] != L'\0')
+		{
+			while (pos < multiSz.length() && multiSz[pos] != L'\0')
+			{
+				++pos;
+			}
+
+			++pos;
+			++count;
+		}
+
+		return count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : Size in bytes of the sequence including the null terminator or 0 if str is null.
+	size_t GetMultiSzSize(LPCSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : Size in bytes of the sequence including the null terminator or 0 if str is null.
+	size_t GetMultiSzSize(LPCWSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Storage of many strings in large blocks, with one allocation per block instead of one per string.
+	// The strings are null-terminated and handed out as views that stay valid until Clear or destruction.
+	class StringArena
+	{
+	public:
+		// pResource : Memory resource used for the blocks and the list of the strings.
+		explicit StringArena(std::pmr::memory_resource* pResource = std::pmr::get_default_resource());
+		~StringArena();
+		StringArena(const StringArena&) = delete;
+		StringArena& operator=(const StringArena&) = delete;
+		// str : String to be stored.
+		// Returns : View of the stored string.
+		std::wstring_view Add(std::wstring_view str);
+		// maxLength : Maximum length of the next string.
+		// Returns : Buffer of maxLength characters where the next string is written before calling Commit.
+		LPWSTR Reserve(size_t maxLength);
+		// length : Length of the string written in the buffer returned by Reserve (not more than maxLength).
+		// Returns : View of the stored string.
+		std::wstring_view Commit(size_t length);
+		// size : Count of strings to keep (the others are discarded, their storage is not reused).
+		void Truncate(size_t size) { items_.resize((std::min)(size, items_.size())); }
+		// Free all the strings.
+		void Clear();
+		// Returns : Count of strings.
+		size_t size() const { return items_.size(); }
+		// Returns : True if there is no strings.
+		bool empty() const { return items_.empty(); }
+		// index : Index of the string (must be lower than size()).
+		// Returns : View of the string (null-terminated).
+		std::wstring_view operator[](size_t index) const { return items_[index]; }
+		std::pmr::vector<std::wstring_view>::const_iterator begin() const { return items_.begin(); }
+		std::pmr::vector<std::wstring_view>::const_iterator end() const { return items_.end(); }
+	private:
+		// Length in characters of a block, unless a longer string needs a larger one.
+		static constexpr size_t BLOCK_LENGTH{ 65536 };
+		struct Block
+		{
+			LPWSTR pBuffer;
+			size_t length;
+		};
+		std::pmr::memory_resource* pResource_;
+		std::pmr::vector<Block> blocks_;
+		std::pmr::vector<std::wstring_view> items_;
+		LPWSTR pNext_;
+		size_t available_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Forward range over a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// The items are views into the sequence, nothing is copied or allocated.
+	template <typename T>
+	class MultiSzView
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::basic_string_view<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+			Iterator() : item_{} {}
+			explicit Iterator(const T* pItem) : item_{ pItem != nullptr && *pItem ? value_type{ pItem } : value_type{} } {}
+			reference operator*() const { return item_; }
+			pointer operator->() const { return &item_; }
+			Iterator& operator++() { *this = Iterator{ item_.data() + item_.length() + 1 }; return *this; }
+			Iterator operator++(int) { auto it{ *this }; ++*this; return it; }
+			bool operator==(const Iterator& other) const { return item_.data() == other.item_.data(); }
+			bool operator!=(const Iterator& other) const { return item_.data() != other.item_.data(); }
+		private:
+			value_type item_;
+		};
+		// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings (can be null).
+		explicit MultiSzView(const T* pMultiSz) : pMultiSz_{ pMultiSz } {}
+		Iterator begin() const { return Iterator{ pMultiSz_ }; }
+		Iterator end() const { return Iterator{}; }
+		// Returns : True if the sequence is null or points to a null terminator.
+		bool empty() const { return pMultiSz_ == nullptr || *pMultiSz_ == 0; }
+	private:
+		const T* pMultiSz_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <typename Callback>
+	void DropFilesList::ForEach(Callback callback) const
+	{
+		if (fWide_)
+		{
+			for (auto item : MultiSzView{ pList_ })
+			{
+				callback(item);
+			}
+		}
+		else
+		{
+			std::wstring buffer{};
+
+			for (auto item : MultiSzView{ reinterpret_cast<LPCSTR>(pList_) })
+			{
+				ConvertItem(item, buffer);
+				callback(std::wstring_view{ buffer });
+			}
+		}
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Builder of a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0" (REG_MULTI_SZ or CF_HDROP).
+	// The items can be any range of std::wstring, std::wstring_view or LPCWSTR. Empty items are skipped since they would end the sequence.
+	template <typename Range>
+	class MultiSzBuilder
+	{
+	public:
+		// items : Items of the sequence. The range must outlive the builder.
+		explicit MultiSzBuilder(const Range& items) : items_{ items }, length_{ 1 }
+		{
+			for (const auto& item : items_)
+			{
+				auto itemLength{ std::wstring_view{ item }.length() };
+				if (itemLength != 0)
+				{
+					length_ += itemLength + 1;
+				}
+			}
+		}
+		// Returns : Length of the sequence in characters including the null terminator.
+		size_t Length() const { return length_; }
+		// Returns : Size in bytes of the sequence including the null terminator.
+		size_t ByteSize() const { return length_ * sizeof(WCHAR); }
+		// Returns : Size in bytes of a DROPFILES structure followed by the sequence.
+		size_t DropFilesSize() const { return sizeof(DROPFILES) + ByteSize(); }
+		// pBuffer : Buffer receiving the sequence.
+		// length : Length of the buffer in characters.
+		// Returns : Count of characters written or 0 if the buffer is too small.
+		size_t Write(LPWSTR pBuffer, size_t length) const
+		{
+			if (length < length_)
+			{
+				return 0;
+			}
+
+			for (const auto& item : items_)
+			{
+				std::wstring_view view{ item };
+				if (!view.empty())
+				{
+					pBuffer += view.copy(pBuffer, view.length());
+					*pBuffer++ = L'\0';
+				}
+			}
+
+			*pBuffer = L'\0';
+			return length_;
+		}
+		// pBuffer : Buffer receiving a DROPFILES structure followed by the sequence (wide characters).
+		// nBytes : Size of the buffer in bytes.
+		// Returns : Count of bytes written or 0 if the buffer is too small.
+		size_t WriteDropFiles(LPVOID pBuffer, size_t nBytes) const
+		{
+			if (nBytes < DropFilesSize())
+			{
+				return 0;
+			}
+
+			auto pDropFiles{ static_cast<DROPFILES*>(pBuffer) };
+			pDropFiles->pFiles = sizeof(DROPFILES);
+			pDropFiles->pt = POINT{};
+			pDropFiles->fNC = FALSE;
+			pDropFiles->fWide = TRUE;
+
+			Write(reinterpret_cast<LPWSTR>(pDropFiles + 1), length_);
+			return DropFilesSize();
+		}
+		// Returns : String holding the sequence (c_str() points to the whole sequence).
+		std::wstring Build() const
+		{
+			std::wstring multiSz(length_ - 1, L'\0');
+			Write(&multiSz[0], length_);
+			return multiSz;
+		}
+		// Returns : DROPFILES structure followed by the sequence, ready to be copied to the clipboard as CF_HDROP.
+		std::vector<BYTE> BuildDropFiles() const
+		{
+			std::vector<BYTE> dropFiles(DropFilesSize());
+			WriteDropFiles(dropFiles.data(), dropFiles.size());
+			return dropFiles;
+		}
+	private:
+		const Range& items_;
+		size_t length_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// items : String literals making the sequence (none of them can be empty).
+	// Returns : Null-terminated sequence of the null-terminated items built at compile time in a constexpr context (c_str() is the multi-sz pointer).
+	template <size_t... N>
+	constexpr StaticString<(N + ... + 1)> MakeMultiSz(const WCHAR(&... items)[N])
+	{
+		static_assert(sizeof...(N) != 0, "A multi-sz needs at least one item.");
+		static_assert(((N > 1) && ...), "A multi-sz item cannot be empty (it would end the sequence).");
+
+		StaticString<(N + ... + 1)> multiSz{};
+		(multiSz.Append(items, N), ...);
+
+		return multiSz;
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
+	std::vector<std::string> GetMultiSzItems(LPCSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// pResource : Memory resource used for the returned container and its items.
+	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
+	std::pmr::vector<std::pmr::string> GetMultiSzItems(LPCSTR pMultiSz, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : All the items in the sequence (converted to wide character string) or an empty container if str is null or points to a null terminator.
+	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// codePage : Code page of the strings (CP_ACP for a DROPFILES list, CP_UTF8...).
+	// Returns : All the items in the sequence (converted to wide character string) or an empty container if str is null or points to a null terminator.
+	std::vector<std::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// codePage : Code page of the strings (CP_ACP for a DROPFILES list, CP_UTF8...).
+	// items : Storage to which all the items in the sequence (converted to wide character string) are appended.
+	void GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage, StringArena& items);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// codePage : Code page of the strings (CP_ACP for a DROPFILES list, CP_UTF8...).
+	// pResource : Memory resource used for the returned container and its items.
+	// Returns : All the items in the sequence (converted to wide character string) or an empty container if str is null or points to a null terminator.
+	std::pmr::vector<std::pmr::wstring> GetMultiSzItemsWide(LPCSTR pMultiSz, UINT codePage, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
+	std::vector<std::wstring> GetMultiSzItems(LPCWSTR pMultiSz);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// items : Storage to which all the items in the sequence are appended.
+	void GetMultiSzItems(LPCWSTR pMultiSz, StringArena& items);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pMultiSz : Pointer to a null-terminated sequence of null-terminated strings "c:\\temp1.txt\0c:\\temp2.txt\0\0".
+	// pResource : Memory resource used for the returned container and its items.
+	// Returns : All the items in the sequence or an empty container if str is null or points to a null terminator.
+	std::pmr::vector<std::pmr::wstring> GetMultiSzItems(LPCWSTR pMultiSz, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading and trailing characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimString(std::wstring str, WCHAR chr);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Trailing characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimStringBack(std::wstring str, WCHAR chr);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimStringFront(std::wstring str, WCHAR chr);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// White space characters, to be used as a character set with the trim functions.
+	inline constexpr WCHAR WHITESPACE[]{ L" \t\n\v\f\r" };
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading and trailing characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimString(std::wstring str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading and trailing characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimString(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading and trailing characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimString(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of trailing characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimStringBack(std::wstring str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Trailing characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimStringBack(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of trailing characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimStringBack(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading characters to be removed.
+	// Returns : Trimmed string.
+	std::wstring TrimStringFront(std::wstring str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimStringFront(std::wstring_view str, WCHAR chr, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading characters to be removed.
+	// pResource : Memory resource used for the returned string.
+	// Returns : Trimmed string.
+	std::pmr::wstring TrimStringFront(std::wstring_view str, std::wstring_view chars, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading and trailing characters to be removed.
+	// Returns : View of str without the leading and trailing characters (nothing is copied).
+	constexpr std::wstring_view TrimStringView(std::wstring_view str, WCHAR chr)
+	{
+		auto trimmed{ str.substr(0, str.find_last_not_of(chr) + 1) };
+		return trimmed.substr((std::min)(trimmed.find_first_not_of(chr), trimmed.length()));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading and trailing characters to be removed.
+	// Returns : View of str without the leading and trailing characters (nothing is copied).
+	std::wstring_view TrimStringView(std::wstring_view str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-16 string to be trimmed.
+	// chars : Set of leading and trailing characters to be removed.
+	// Returns : View of str without the leading and trailing characters (nothing is copied).
+	std::u16string_view TrimStringView(std::u16string_view str, std::u16string_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Trailing characters to be removed.
+	// Returns : View of str without the trailing characters (nothing is copied).
+	constexpr std::wstring_view TrimStringBackView(std::wstring_view str, WCHAR chr)
+	{
+		return str.substr(0, str.find_last_not_of(chr) + 1);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of trailing characters to be removed.
+	// Returns : View of str without the trailing characters (nothing is copied).
+	std::wstring_view TrimStringBackView(std::wstring_view str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-16 string to be trimmed.
+	// chars : Set of trailing characters to be removed.
+	// Returns : View of str without the trailing characters (nothing is copied).
+	std::u16string_view TrimStringBackView(std::u16string_view str, std::u16string_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chr : Leading characters to be removed.
+	// Returns : View of str without the leading characters (nothing is copied).
+	constexpr std::wstring_view TrimStringFrontView(std::wstring_view str, WCHAR chr)
+	{
+		return str.substr((std::min)(str.find_first_not_of(chr), str.length()));
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Set of leading characters to be removed.
+	// Returns : View of str without the leading characters (nothing is copied).
+	std::wstring_view TrimStringFrontView(std::wstring_view str, std::wstring_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-16 string to be trimmed.
+	// chars : Set of leading characters to be removed.
+	// Returns : View of str without the leading characters (nothing is copied).
+	std::u16string_view TrimStringFrontView(std::u16string_view str, std::u16string_view chars);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Character or set of leading and trailing characters to be removed (WCHAR or anything convertible to std::wstring_view).
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written.
+	template <typename Chars, typename OutputIt>
+	size_t TrimStringTo(std::wstring_view str, const Chars& chars, OutputIt&& out)
+	{
+		auto trimmed{ TrimStringView(str, chars) };
+		out = std::copy(trimmed.begin(), trimmed.end(), out);
+		return trimmed.length();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Character or set of trailing characters to be removed (WCHAR or anything convertible to std::wstring_view).
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written.
+	template <typename Chars, typename OutputIt>
+	size_t TrimStringBackTo(std::wstring_view str, const Chars& chars, OutputIt&& out)
+	{
+		auto trimmed{ TrimStringBackView(str, chars) };
+		out = std::copy(trimmed.begin(), trimmed.end(), out);
+		return trimmed.length();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be trimmed.
+	// chars : Character or set of leading characters to be removed (WCHAR or anything convertible to std::wstring_view).
+	// out : Output iterator receiving the characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written.
+	template <typename Chars, typename OutputIt>
+	size_t TrimStringFrontTo(std::wstring_view str, const Chars& chars, OutputIt&& out)
+	{
+		auto trimmed{ TrimStringFrontView(str, chars) };
+		out = std::copy(trimmed.begin(), trimmed.end(), out);
+		return trimmed.length();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be processed.
+	// Returns : Wide character string.
+	std::wstring WStrFromStr(LPCSTR pStr);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be processed.
+	// codePage : Code page of the string (CP_ACP, CP_UTF8...).
+	// Returns : Wide character string.
+	std::wstring WStrFromStr(LPCSTR pStr, UINT codePage);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be processed.
+	// codePage : Code page of the string (CP_ACP, CP_UTF8...).
+	// pResource : Memory resource used for the returned string.
+	// Returns : Wide character string.
+	std::pmr::wstring WStrFromStr(LPCSTR pStr, UINT codePage, std::pmr::memory_resource* pResource);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be widened (each byte is taken as a Latin-1 character).
+	// length : Length of the string in bytes.
+	// pBuffer : Buffer receiving the wide characters (length characters, no null terminator added).
+	void WidenString(LPCSTR pStr, size_t length, LPWSTR pBuffer);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be widened (each byte is taken as a Latin-1 character).
+	// length : Length of the string in bytes.
+	// pBuffer : Buffer receiving the UTF-16 characters (length characters, no null terminator added).
+	void WidenString(LPCSTR pStr, size_t length, char16_t* pBuffer);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : String to be validated.
+	// Returns : True if the string is well-formed UTF-8.
+	bool IsValidUtf8(std::string_view str);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-8 string to be converted (ill-formed sequences are replaced with U+FFFD).
+	// Returns : UTF-16 string.
+	std::wstring Utf8ToUtf16(std::string_view str);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-16 string to be converted (unpaired surrogates are replaced with U+FFFD).
+	// Returns : UTF-8 string.
+	std::string Utf16ToUtf8(std::wstring_view str);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// str : UTF-16 string to be converted (unpaired surrogates are replaced with U+FFFD).
+	// Returns : UTF-8 string.
+	std::string Utf16ToUtf8(std::u16string_view str);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Streaming UTF-8 to UTF-16 decoder. A sequence split between two chunks is completed with the next chunk.
+	// Ill-formed sequences are replaced with U+FFFD.
+	class Utf8Decoder
+	{
+	public:
+		Utf8Decoder();
+		// chunkLength : Length of a chunk in bytes.
+		// Returns : Length of the buffer needed by Decode for a chunk of that length.
+		static constexpr size_t GetMaxLength(size_t chunkLength) { return chunkLength + 4; }
+		// chunk : Next chunk of the UTF-8 string.
+		// pBuffer : Buffer receiving the UTF-16 characters (GetMaxLength characters, no null terminator added).
+		// Returns : Count of characters written.
+		size_t Decode(std::string_view chunk, LPWSTR pBuffer);
+		// chunk : Next chunk of the UTF-8 string.
+		// str : String to which the UTF-16 characters are appended.
+		void Decode(std::string_view chunk, std::wstring& str);
+		// pBuffer : Buffer receiving the replacement of an incomplete trailing sequence (1 character).
+		// Returns : Count of characters written. The decoder is ready for a new string.
+		size_t Finish(LPWSTR pBuffer);
+	private:
+		BYTE pending_[4];
+		size_t pendingLength_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pStr : String to be processed.
+	// codePage : Code page of the string (CP_UTF8 is decoded by chunks, other code pages go through one temporary string).
+	// out : Output iterator receiving the wide characters (advanced past them when passed as an lvalue).
+	// Returns : Count of characters written.
+	template <typename OutputIt>
+	size_t WStrFromStrTo(LPCSTR pStr, UINT codePage, OutputIt&& out)
+	{
+		if (codePage != CP_UTF8)
+		{
+			auto wideStr{ WStrFromStr(pStr, codePage) };
+			out = std::copy(wideStr.begin(), wideStr.end(), out);
+			return wideStr.length();
+		}
+
+		constexpr size_t CHUNK_LENGTH{ 256 };
+		WCHAR buffer[Utf8Decoder::GetMaxLength(CHUNK_LENGTH)];
+		std::string_view str{ pStr };
+		Utf8Decoder decoder{};
+		size_t count{ 0 };
+
+		for (size_t pos{ 0 }; pos < str.length(); pos += CHUNK_LENGTH)
+		{
+			auto length{ decoder.Decode(str.substr(pos, CHUNK_LENGTH), buffer) };
+			out = std::copy(buffer, buffer + length, out);
+			count += length;
+		}
+
+		auto length{ decoder.Finish(buffer) };
+		out = std::copy(buffer, buffer + length, out);
+
+		return count + length;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      thread
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Options of ParallelForEachOrdered.
+	struct ParallelOptions
+	{
+		// Count of workers, including the calling thread (0 for the count of logical processors).
+		size_t threadCount{ 0 };
+		// Maximum count of items being transformed or waiting to be consumed (0 for 4 items per thread).
+		// The workers wait when they get that far ahead of the consumer.
+		size_t maxInFlight{ 0 };
+		// Flag checked before each item, the processing stops as soon as it becomes true (can be null).
+		const std::atomic<bool>* pCancel{ nullptr };
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Indices of the items processed by a pool of workers. Each worker takes the indices of its own range from the
+	// front. When its range is empty it takes the next chunk of indices, so the indices are handed out in order and
+	// stay close to the consumer. Once all the chunks are taken it steals the front half of the range of the other
+	// worker that is the most behind.
+	class WorkStealingQueue
+	{
+	public:
+		// count : Count of items (indices 0 to count - 1).
+		// workerCount : Count of workers (at least 1).
+		// chunkSize : Count of consecutive indices taken at once by a worker (at least 1).
+		WorkStealingQueue(size_t count, size_t workerCount, size_t chunkSize);
+		// worker : Index of the worker.
+		// index : Receives the index of the next item to be processed.
+		// Returns : True if an index has been taken or false if there is no more items.
+		bool Pop(size_t worker, size_t& index);
+	private:
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4324) // The padding is intended, each range has its own cache line.
+#endif
+		struct alignas(64) Range
+		{
+			std::mutex mutex;
+			size_t begin;
+			size_t end;
+		};
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+		std::unique_ptr<Range[]> ranges_;
+		size_t workerCount_;
+		size_t count_;
+		size_t chunkSize_;
+		// First index of the next chunk.
+		std::atomic<size_t> next_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Pool of worker threads kept between the calls of ParallelForEachOrdered, so a call doesn't create its own threads.
+	// A thread is added when no idle thread is left, up to the count of logical processors. The jobs no thread has
+	// taken are run by the caller once its own work is done, so concurrent and nested calls never wait for each other.
+	class WorkerPool
+	{
+	public:
+		WorkerPool();
+		// Stops and joins the threads (no call to Run must be in progress).
+		~WorkerPool();
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+		// Returns : Pool shared by the process, its threads are joined when it's destroyed at exit.
+		static WorkerPool& GetShared();
+		// workerCount : Count of jobs running work.
+		// work : Function called once for each job with the index of the worker (0 to workerCount - 1), on a pool thread
+		//        or on the calling thread once local has returned.
+		// local : Function called on the calling thread while the workers run, it must not wait for a job to start.
+		// Returns once local and all the calls of work have returned. The first exception thrown by one of them is rethrown.
+		void Run(size_t workerCount, const std::function<void(size_t)>& work, const std::function<void()>& local);
+	private:
+		// Jobs queued by a call of Run (on the stack of the call).
+		struct Batch
+		{
+			const std::function<void(size_t)>* pWork;
+			size_t remaining;
+			std::exception_ptr exception;
+		};
+		struct Job
+		{
+			Batch* pBatch;
+			size_t worker;
+		};
+		// Loop of a pool thread, running the jobs until the pool is stopped.
+		void ThreadProc();
+		std::mutex mutex_;
+		// Signaled when a job is queued or when the pool is stopped.
+		std::condition_variable jobReady_;
+		// Signaled when a job has returned.
+		std::condition_variable jobDone_;
+		std::deque<Job> jobs_;
+		std::vector<std::thread> threads_;
+		size_t maxThreads_;
+		// Count of threads running a job.
+		size_t busy_;
+		bool stop_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// count : Count of items (indices 0 to count - 1).
+	// transform : Function called concurrently by worker threads with the index of an item and returning its result (not void).
+	// consume : Function called on the calling thread with the index and the result of each item, in index order. The
+	//           calling thread also transforms items while the result it waits for isn't ready.
+	// options : Count of threads, back-pressure and cancellation.
+	// Returns : True if all the items have been consumed or false if cancelled. The first exception thrown by
+	//           transform or consume stops the processing and is rethrown once all the worker threads are done.
+	// The other workers are threads of the shared WorkerPool, they are created by the first calls and reused by the next ones.
+	template <typename Transform, typename Consume>
+	bool ParallelForEachOrdered(size_t count, Transform transform, Consume consume, const ParallelOptions& options = ParallelOptions{})
+	{
+		using Result = std::invoke_result_t<Transform&, size_t>;
+
+		if (count == 0)
+		{
+			return true;
+		}
+
+		size_t threadCount{ options.threadCount != 0 ? options.threadCount : (std::max)(std::thread::hardware_concurrency(), 1u) };
+		threadCount = (std::min)(threadCount, count);
+		auto maxInFlight{ options.maxInFlight != 0 ? options.maxInFlight : threadCount * 4 };
+
+		auto isCancelled{ [&options] { return options.pCancel != nullptr && options.pCancel->load(std::memory_order_relaxed); } };
+
+		// Chunks small enough for every worker to hold a few of them within the window.
+		WorkStealingQueue queue{ count, threadCount, (std::max)(maxInFlight / (threadCount * 2), size_t{ 1 }) };
+		// Results waiting to be consumed, the result of an item goes to the slot index % maxInFlight.
+		std::vector<std::optional<Result>> results(maxInFlight);
+		std::mutex mutex{};
+		std::condition_variable resultReady{};
+		std::condition_variable windowOpen{};
+		size_t next{ 0 };
+		auto stop{ false };
+		std::exception_ptr exception{};
+
+		auto stopAll{ [&](std::exception_ptr error)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				if (error != nullptr && exception == nullptr)
+				{
+					exception = error;
+				}
+
+				stop = true;
+			}
+
+			resultReady.notify_all();
+			windowOpen.notify_all();
+		} };
+
+		// Returns : False if the processing has to stop.
+		auto transformItem{ [&](size_t index)
+		{
+			if (isCancelled())
+			{
+				stopAll(nullptr);
+				return false;
+			}
+
+			try
+			{
+				auto result{ transform(index) };
+				std::lock_guard<std::mutex> lock{ mutex };
+				results[index % maxInFlight].emplace(std::move(result));
+			}
+			catch (...)
+			{
+				stopAll(std::current_exception());
+				return false;
+			}
+
+			resultReady.notify_all();
+			return true;
+		} };
+
+		auto work{ [&](size_t worker)
+		{
+			size_t index;
+			while (queue.Pop(worker, index))
+			{
+				{
+					std::unique_lock<std::mutex> lock{ mutex };
+					windowOpen.wait(lock, [&] { return stop || index < next + maxInFlight; });
+					if (stop)
+					{
+						return;
+					}
+				}
+
+				if (!transformItem(index))
+				{
+					return;
+				}
+			}
+		} };
+
+		// The calling thread is the last worker. It can't wait for the window to open since it's the one moving it, so
+		// an index taken beyond the window is kept until the window reaches it.
+		auto consumeAll{ [&]
+		{
+			size_t pending{};
+			auto hasPending{ false };
+
+			try
+			{
+				while (next < count && !isCancelled())
+				{
+					auto& slot{ results[next % maxInFlight] };
+					std::optional<Result> result{};
+
+					{
+						std::lock_guard<std::mutex> lock{ mutex };
+						if (stop)
+						{
+							break;
+						}
+
+						result.swap(slot);
+					}
+
+					if (!result.has_value())
+					{
+						if (!hasPending)
+						{
+							hasPending = queue.Pop(threadCount - 1, pending);
+						}
+
+						if (hasPending && pending < next + maxInFlight)
+						{
+							hasPending = false;
+							if (!transformItem(pending))
+							{
+								break;
+							}
+						}
+						else
+						{
+							std::unique_lock<std::mutex> lock{ mutex };
+							resultReady.wait(lock, [&] { return stop || slot.has_value(); });
+						}
+
+						continue;
+					}
+
+					consume(next, std::move(*result));
+
+					{
+						std::lock_guard<std::mutex> lock{ mutex };
+						++next;
+					}
+
+					windowOpen.notify_all();
+				}
+			}
+			catch (...)
+			{
+				stopAll(std::current_exception());
+			}
+
+			stopAll(nullptr);
+		} };
+
+		WorkerPool::GetShared().Run(threadCount - 1, work, consumeAll);
+
+		if (exception != nullptr)
+		{
+			std::rethrow_exception(exception);
+		}
+
+		return next == count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <typename Transform, typename Consume>
+	bool DropFilesList::ParallelForEach(Transform transform, Consume consume, const ParallelOptions& options) const
+	{
+		// The index is built before the workers read it concurrently.
+		auto count{ Count() };
+
+		return ParallelForEachOrdered(count, [this, &transform](size_t index)
+		{
+			if (fWide_)
+			{
+				return transform(wideIndex_[index]);
+			}
+
+			// The narrow items are converted in a buffer reused by the items of the same worker.
+			thread_local std::wstring buffer{};
+			ConvertItem(narrowIndex_[index], buffer);
+			return transform(std::wstring_view{ buffer });
+		}, consume, options);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//
+	//                                      trace
+	//
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	enum class TraceEventType : BYTE
+	{
+		Begin,
+		End,
+		Instant
+	};
+
+	enum class TraceFormat
+	{
+		// Chrome trace_event JSON (chrome://tracing, Perfetto).
+		Json,
+		// "HLPTRACE", UINT32 version (1), then records starting with a BYTE kind:
+		// 0 : name, UINT32 id, UINT32 length, UTF-8 characters.
+		// 1 + TraceEventType : event, UINT32 name id, DWORD thread id, UINT64 nanoseconds since StartTrace.
+		Binary
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns : Flag set while a trace is being recorded.
+	inline std::atomic<bool>& GetTraceFlag()
+	{
+		static std::atomic<bool> enabled{ false };
+		return enabled;
+	}
+
+	// Returns : True if a trace is being recorded.
+	inline bool IsTraceEnabled()
+	{
+		return GetTraceFlag().load(std::memory_order_relaxed);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Records an event in the ring buffer of the calling thread if a trace is being recorded. The event is dropped
+	// if the buffer is full (the flusher empties the buffers every 10 ms).
+	// pName : Name of the event, it must stay valid until the trace is stopped (a string literal).
+	// type : Type of the event.
+	void RecordTraceEvent(LPCWSTR pName, TraceEventType type);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Records a Begin event when constructed and an End event when destroyed, only a flag test if no trace is recorded.
+	class TraceScope
+	{
+	public:
+		// pName : Name of the scope, it must stay valid until the trace is stopped (a string literal).
+		explicit TraceScope(LPCWSTR pName) : pName_{ IsTraceEnabled() ? pName : nullptr }
+		{
+			if (pName_ != nullptr)
+			{
+				RecordTraceEvent(pName_, TraceEventType::Begin);
+			}
+		}
+		~TraceScope()
+		{
+			if (pName_ != nullptr)
+			{
+				RecordTraceEvent(pName_, TraceEventType::End);
+			}
+		}
+	private:
+		LPCWSTR pName_;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// pFilePath : Path of the file receiving the trace (overwritten), written by a background thread.
+	// format : Format of the trace.
+	// Returns : True if the trace has been started (false if a trace is already being recorded).
+	bool StartTrace(LPCWSTR pFilePath, TraceFormat format = TraceFormat::Json);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Stops the recording, writes the remaining events and closes the file (done at exit if the trace is not stopped).
+	// Returns : True if a trace was being recorded and it has been written successfully.
+	bool StopTrace();
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns : Count of events dropped because a ring buffer was full since the trace has been started.
+	UINT64 GetTraceDroppedCount();
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Windows owning the memory clipboard in turn, the backend only compares them.
+	const auto hWndFirst{ reinterpret_cast<HWND>(static_cast<uintptr_t>(1)) };
+	const auto hWndSecond{ reinterpret_cast<HWND>(static_cast<uintptr_t>(2)) };
+
+	constexpr UINT FORMAT{ 0xC001 };
+
+	// Provider publishing a single format with its producer counting the renderings, the messages of the
+	// first window are forwarded to it.
+	class ClipboardTests : public testing::Test
+	{
+	protected:
+		hlp::MemoryClipboardBackend backend_{};
+		hlp::DelayedClipboardProvider provider_{ backend_ };
+		size_t produced_{ 0 };
+
+		void SetUp() override
+		{
+			provider_.AddFormat(FORMAT, [this]()
+			{
+				++produced_;
+				return std::vector<BYTE>{ 1, 2, 3 };
+			});
+
+			backend_.SetMessageHandler([this](HWND hWnd, UINT uMsg, WPARAM wParam)
+			{
+				if (hWnd == hWndFirst)
+				{
+					provider_.HandleMessage(hWnd, uMsg, wParam);
+				}
+			});
+		}
+	};
+
+	TEST(ClipboardTransactionTests, SetsSeveralFormatsUnderOneOpen)
+	{
+		hlp::MemoryClipboardBackend backend{};
+		const std::vector<std::wstring> files{ L"c:\\dir\\a.txt", L"c:\\dir\\b.txt" };
+
+		{
+			hlp::ClipboardTransaction transaction{ backend };
+			ASSERT_TRUE(transaction.Open(hWndFirst));
+			EXPECT_TRUE(transaction.SetText(L"text"));
+
+			auto dropFiles{ hlp::MultiSzBuilder{ files }.BuildDropFiles() };
+			EXPECT_TRUE(transaction.SetData(CF_HDROP, dropFiles.data(), dropFiles.size()));
+
+			// The writer fills the memory block of the clipboard, a writer returning false cancels its format.
+			EXPECT_TRUE(transaction.SetData(FORMAT, 4, [](LPVOID pMem, SIZE_T nBytes)
+			{
+				std::fill_n(static_cast<BYTE*>(pMem), nBytes, BYTE{ 7 });
+				return true;
+			}));
+			EXPECT_FALSE(transaction.SetData(FORMAT + 1, 4, [](LPVOID, SIZE_T) { return false; }));
+			EXPECT_TRUE(backend.IsOpen());
+		}
+
+		EXPECT_FALSE(backend.IsOpen());
+		EXPECT_EQ(1u, backend.GetOpenCount());
+		EXPECT_EQ(3u, backend.GetFormatCount());
+
+		auto pText{ backend.GetData(CF_UNICODETEXT) };
+		ASSERT_NE(nullptr, pText);
+		EXPECT_EQ(L"text", std::wstring_view{ reinterpret_cast<LPCWSTR>(pText->data()) });
+
+		auto pDropFiles{ backend.GetData(CF_HDROP) };
+		ASSERT_NE(nullptr, pDropFiles);
+		hlp::DropFilesList list{};
+		ASSERT_TRUE(list.Load(pDropFiles->data(), pDropFiles->size()));
+		EXPECT_EQ(files, list.GetItems());
+
+		auto pCustom{ backend.GetData(FORMAT) };
+		ASSERT_NE(nullptr, pCustom);
+		EXPECT_EQ((std::vector<BYTE>{ 7, 7, 7, 7 }), *pCustom);
+		EXPECT_EQ(nullptr, backend.GetData(FORMAT + 1));
+	}
+
+	TEST_F(ClipboardTests, FormatIsRenderedOnRequest)
+	{
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		EXPECT_EQ(0u, produced_);
+		EXPECT_EQ(nullptr, backend_.GetData(FORMAT));
+
+		auto pData{ backend_.RequestData(FORMAT) };
+		ASSERT_NE(nullptr, pData);
+		EXPECT_EQ(3u, pData->size());
+		EXPECT_EQ(1u, produced_);
+		EXPECT_EQ(3u, provider_.GetCacheSize());
+	}
+
+	TEST_F(ClipboardTests, RepublishingKeepsTheProducers)
+	{
+		// Emptying the clipboard sends WM_DESTROYCLIPBOARD to the window publishing again.
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		EXPECT_EQ(1u, backend_.GetFormatCount());
+
+		ASSERT_NE(nullptr, backend_.RequestData(FORMAT));
+		EXPECT_EQ(1u, produced_);
+	}
+
+	TEST_F(ClipboardTests, ReplacedDataReleasesTheCacheOnly)
+	{
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		ASSERT_NE(nullptr, backend_.RequestData(FORMAT));
+		EXPECT_EQ(3u, provider_.GetCacheSize());
+
+		// Another window takes the clipboard, the first one receives WM_DESTROYCLIPBOARD.
+		hlp::ClipboardTransaction transaction{ backend_ };
+		ASSERT_TRUE(transaction.Open(hWndSecond));
+		transaction.Close();
+		EXPECT_EQ(0u, provider_.GetCacheSize());
+
+		// The formats can still be published and produced.
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		ASSERT_NE(nullptr, backend_.RequestData(FORMAT));
+		EXPECT_EQ(2u, produced_);
+	}
+
+	TEST_F(ClipboardTests, RenderAllFormatsOnlyWhileOwner)
+	{
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		EXPECT_TRUE(provider_.RenderAllFormats(hWndFirst));
+		EXPECT_NE(nullptr, backend_.GetData(FORMAT));
+		EXPECT_EQ(1u, produced_);
+
+		ASSERT_TRUE(provider_.Publish(hWndFirst));
+		hlp::ClipboardTransaction transaction{ backend_ };
+		ASSERT_TRUE(transaction.Open(hWndSecond));
+		transaction.Close();
+
+		EXPECT_TRUE(provider_.RenderAllFormats(hWndFirst));
+		EXPECT_EQ(nullptr, backend_.GetData(FORMAT));
+		EXPECT_EQ(1u, produced_);
+	}
+
+}
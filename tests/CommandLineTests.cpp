@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Returns : Random string made of the characters that matter to the quoting rules.
+	std::wstring BuildRandomString(std::mt19937& random, size_t maxLength)
+	{
+		static const WCHAR CHARS[]{ L"ab \t\"\\\\\\\u00E9" };
+		std::uniform_int_distribution<size_t> length{ 0, maxLength };
+		std::uniform_int_distribution<size_t> chr{ 0, std::size(CHARS) - 2 };
+
+		std::wstring str(length(random), L'\0');
+		for (auto& c : str)
+		{
+			c = CHARS[chr(random)];
+		}
+
+		return str;
+	}
+
+	// Parser copying every character, following the same rules.
+	std::vector<std::wstring> CopyParse(std::wstring_view commandLine)
+	{
+		std::vector<std::wstring> arguments{};
+		auto isBlank{ [](WCHAR chr) { return chr == L' ' || chr == L'\t'; } };
+		size_t index{ 0 };
+
+		for (;;)
+		{
+			while (index < commandLine.length() && isBlank(commandLine[index]))
+			{
+				++index;
+			}
+
+			if (index == commandLine.length())
+			{
+				return arguments;
+			}
+
+			std::wstring argument{};
+			auto quoted{ false };
+
+			while (index < commandLine.length() && (quoted || !isBlank(commandLine[index])))
+			{
+				if (commandLine[index] == L'\\')
+				{
+					size_t backslashes{ 0 };
+					for (; index < commandLine.length() && commandLine[index] == L'\\'; ++index)
+					{
+						++backslashes;
+					}
+
+					if (index < commandLine.length() && commandLine[index] == L'"')
+					{
+						argument.append(backslashes / 2, L'\\');
+						if (backslashes % 2 != 0)
+						{
+							argument += L'"';
+							++index;
+						}
+					}
+					else
+					{
+						argument.append(backslashes, L'\\');
+					}
+				}
+				else if (commandLine[index] == L'"')
+				{
+					if (quoted && index + 1 < commandLine.length() && commandLine[index + 1] == L'"')
+					{
+						argument += L'"';
+						index += 2;
+					}
+					else
+					{
+						quoted = !quoted;
+						++index;
+					}
+				}
+				else
+				{
+					argument += commandLine[index++];
+				}
+			}
+
+			arguments.push_back(argument);
+		}
+	}
+
+	TEST(CommandLineTests, EscapedArgumentsRoundTrip)
+	{
+		std::mt19937 random{ 2019 };
+		std::uniform_int_distribution<size_t> argumentCount{ 0, 8 };
+		hlp::CommandLineArguments parsed{};
+
+		for (int i{ 0 }; i < 20000; ++i)
+		{
+			std::vector<std::wstring> arguments(argumentCount(random));
+			for (auto& argument : arguments)
+			{
+				argument = BuildRandomString(random, 20);
+			}
+
+			auto commandLine{ hlp::CommandLineBuilder{ arguments }.Build() };
+			parsed.Load(commandLine);
+
+			ASSERT_EQ(arguments.size(), parsed.size()) << "iteration " << i;
+			for (size_t j{ 0 }; j < arguments.size(); ++j)
+			{
+				ASSERT_EQ(arguments[j], std::wstring{ parsed[j] }) << "iteration " << i << " argument " << j;
+			}
+		}
+	}
+
+	TEST(CommandLineTests, ParseMatchesCopyingParser)
+	{
+		std::mt19937 random{ 2019 };
+		hlp::CommandLineArguments parsed{};
+
+		for (int i{ 0 }; i < 20000; ++i)
+		{
+			auto commandLine{ BuildRandomString(random, 60) };
+			auto expected{ CopyParse(commandLine) };
+			parsed.Load(commandLine);
+
+			ASSERT_EQ(expected, std::vector<std::wstring>(parsed.begin(), parsed.end())) << "iteration " << i;
+		}
+	}
+
+	TEST(CommandLineTests, PlainArgumentsPointIntoCommandLine)
+	{
+		std::wstring commandLine{ L"app.exe  c:\\dir\\file.txt \"quoted arg\" last" };
+		hlp::CommandLineArguments parsed{};
+		parsed.Load(commandLine);
+
+		ASSERT_EQ(4u, parsed.size());
+		EXPECT_EQ(L"quoted arg", parsed[2]);
+
+		for (size_t i : { 0, 1, 3 })
+		{
+			EXPECT_GE(parsed[i].data(), commandLine.data());
+			EXPECT_LE(parsed[i].data() + parsed[i].length(), commandLine.data() + commandLine.length());
+		}
+	}
+
+}
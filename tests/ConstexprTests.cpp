@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// The constexpr string functions must stay usable at compile time.
+	static_assert(hlp::GetEscapedBackslashLength(L"c:\\temp\\") == 10);
+	static_assert(hlp::StaticEscapeBackslash(L"\\\\?\\c:").view() == L"\\\\\\\\?\\\\c:");
+	static_assert(hlp::MakeMultiSz(L"a", L"bc").view() == std::wstring_view{ L"a\0bc\0", 5 });
+	static_assert(hlp::MakeMultiSz(L"a", L"bc").ByteSize() == 6 * sizeof(WCHAR));
+	static_assert(hlp::GetMultiSzCount(hlp::MakeMultiSz(L"a", L"bc", L"def").view()) == 3);
+	static_assert(hlp::GetMultiSzCount(std::wstring_view{ L"a\0\0b\0", 6 }) == 1);
+	static_assert(hlp::TrimStringView(L"  a b  ", L' ') == L"a b");
+	static_assert(hlp::TrimStringBackView(L"xax", L'x') == L"xa");
+	static_assert(hlp::TrimStringFrontView(L"xxx", L'x').empty());
+
+	TEST(ConstexprTests, ConstantsMatchTheRuntimeFunctions)
+	{
+		constexpr auto multiSz{ hlp::MakeMultiSz(L"c:\\a.txt", L"c:\\dir") };
+		EXPECT_EQ((std::vector<std::wstring>{ L"c:\\a.txt", L"c:\\dir" }), hlp::GetMultiSzItems(multiSz.c_str()));
+
+		constexpr auto escaped{ hlp::StaticEscapeBackslash(L"c:\\temp\\") };
+		EXPECT_EQ(hlp::EscapeBackslash(L"c:\\temp\\"), escaped.view());
+	}
+
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Returns : CF_HDROP memory block with a list of narrow items.
+	std::vector<BYTE> BuildNarrowDropFiles(std::string_view multiSz)
+	{
+		std::vector<BYTE> block(sizeof(DROPFILES) + multiSz.length());
+		auto pDropFiles{ reinterpret_cast<DROPFILES*>(block.data()) };
+		pDropFiles->pFiles = sizeof(DROPFILES);
+		pDropFiles->fWide = FALSE;
+		std::copy(multiSz.begin(), multiSz.end(), block.begin() + sizeof(DROPFILES));
+		return block;
+	}
+
+	TEST(DropFilesListTests, LoadWideList)
+	{
+		std::vector<std::wstring> items{ L"c:\\temp1.txt", L"c:\\dir\\temp2.txt", L"d:\\temp3.txt" };
+		auto block{ hlp::MultiSzBuilder{ items }.BuildDropFiles() };
+
+		hlp::DropFilesList list{};
+		ASSERT_TRUE(list.Load(block.data(), block.size()));
+		EXPECT_TRUE(list.IsMultiItems());
+		EXPECT_EQ(items.front(), list.GetFirstItem());
+		EXPECT_EQ(items, list.GetItems());
+		ASSERT_EQ(items.size(), list.Count());
+
+		for (size_t i{ 0 }; i < items.size(); ++i)
+		{
+			EXPECT_EQ(items[i], list.GetItem(i));
+		}
+
+		std::vector<std::wstring> visited{};
+		list.ForEach([&visited](std::wstring_view item) { visited.emplace_back(item); });
+		EXPECT_EQ(items, visited);
+	}
+
+	TEST(DropFilesListTests, LoadNarrowList)
+	{
+		auto block{ BuildNarrowDropFiles(std::string_view{ "c:\\a.txt\0c:\\b\xE9.txt\0\0", 20 }) };
+
+		hlp::DropFilesList list{};
+		ASSERT_TRUE(list.Load(block.data(), block.size()));
+		EXPECT_EQ((std::vector<std::wstring>{ L"c:\\a.txt", L"c:\\b\u00E9.txt" }), list.GetItems());
+		EXPECT_EQ(L"c:\\b\u00E9.txt", list.GetItem(1));
+	}
+
+	TEST(DropFilesListTests, RejectsUnterminatedList)
+	{
+		auto block{ BuildNarrowDropFiles(std::string_view{ "c:\\a.txt\0c:\\b", 13 }) };
+
+		hlp::DropFilesList list{};
+		EXPECT_FALSE(list.Load(block.data(), block.size()));
+		EXPECT_FALSE(list.Load(block.data(), sizeof(DROPFILES) - 1));
+		EXPECT_EQ(0u, list.GetItems().size());
+	}
+
+	TEST(DropFilesListTests, ParallelForEachPassesViews)
+	{
+		std::vector<std::wstring> items{ L"c:\\temp1.txt", L"c:\\dir\\temp2.txt", L"d:\\temp3.txt" };
+		auto wideBlock{ hlp::MultiSzBuilder{ items }.BuildDropFiles() };
+		auto narrowBlock{ BuildNarrowDropFiles(std::string_view{ "c:\\temp1.txt\0c:\\dir\\temp2.txt\0d:\\temp3.txt\0\0", 44 }) };
+
+		for (auto pBlock : { &wideBlock, &narrowBlock })
+		{
+			hlp::DropFilesList list{};
+			ASSERT_TRUE(list.Load(pBlock->data(), pBlock->size()));
+
+			std::vector<std::wstring> visited{};
+			auto completed{ list.ParallelForEach([](std::wstring_view item) { return std::wstring{ item }; },
+				[&visited](size_t, std::wstring item) { visited.push_back(std::move(item)); }, hlp::ParallelOptions{}) };
+
+			EXPECT_TRUE(completed);
+			EXPECT_EQ(items, visited);
+		}
+	}
+
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Previous implementations, escaping backwards with an insert per character.
+
+	std::wstring InsertEscapeBackslash(std::wstring str)
+	{
+		auto index{ str.length() };
+
+		while (--index != str.npos)
+		{
+			if (str[index] == L'\\')
+			{
+				str.insert(index, 1, L'\\');
+			}
+		}
+
+		return str;
+	}
+
+	std::wstring InsertEscapeArgument(std::wstring argument)
+	{
+		if (!argument.empty())
+		{
+			if (argument.find_first_of(L" \"\t") == argument.npos)
+			{
+				return argument;
+			}
+
+			auto index{ argument.length() };
+			auto quote{ true };
+
+			while (--index != argument.npos)
+			{
+				if (quote && argument[index] == L'\\')
+				{
+					argument.insert(index, 1, L'\\');
+				}
+				else if (argument[index] == L'"')
+				{
+					argument.insert(index, 1, L'\\');
+					quote = true;
+				}
+				else if (quote == true)
+				{
+					quote = false;
+				}
+			}
+		}
+
+		return std::wstring{ L'"' + argument + L'"' };
+	}
+
+	// Returns : Random string made of the characters that matter to the escaping.
+	std::wstring BuildRandomString(std::mt19937& random)
+	{
+		static const WCHAR CHARS[]{ L"ab \t\"\\\\\\" };
+		std::uniform_int_distribution<size_t> length{ 0, 40 };
+		std::uniform_int_distribution<size_t> chr{ 0, std::size(CHARS) - 2 };
+
+		std::wstring str(length(random), L'\0');
+		for (auto& c : str)
+		{
+			c = CHARS[chr(random)];
+		}
+
+		return str;
+	}
+
+	TEST(EscapeTests, EscapeBackslashMatchesPrevious)
+	{
+		std::mt19937 random{ 2019 };
+
+		for (int i{ 0 }; i < 20000; ++i)
+		{
+			auto str{ BuildRandomString(random) };
+			auto expected{ InsertEscapeBackslash(str) };
+
+			ASSERT_EQ(expected, hlp::EscapeBackslash(str)) << "iteration " << i;
+			auto escaped{ hlp::EscapeBackslash(str, std::pmr::get_default_resource()) };
+			ASSERT_EQ(expected, std::wstring(escaped.begin(), escaped.end())) << "iteration " << i;
+			ASSERT_EQ(expected.length(), hlp::GetEscapedBackslashLength(str)) << "iteration " << i;
+
+			std::wstring written{};
+			ASSERT_EQ(expected.length(), hlp::EscapeBackslashTo(str, std::back_inserter(written))) << "iteration " << i;
+			ASSERT_EQ(expected, written) << "iteration " << i;
+		}
+	}
+
+	TEST(EscapeTests, EscapeArgumentMatchesPrevious)
+	{
+		std::mt19937 random{ 2019 };
+
+		for (int i{ 0 }; i < 20000; ++i)
+		{
+			auto argument{ BuildRandomString(random) };
+			auto expected{ InsertEscapeArgument(argument) };
+
+			ASSERT_EQ(expected, hlp::EscapeArgument(argument)) << "iteration " << i;
+			ASSERT_EQ(expected.length(), hlp::GetEscapedArgumentLength(argument)) << "iteration " << i;
+
+			std::wstring buffer(expected.length(), L'\0');
+			ASSERT_EQ(&buffer[0] + buffer.length(), hlp::EscapeArgument(argument, &buffer[0])) << "iteration " << i;
+			ASSERT_EQ(expected, buffer) << "iteration " << i;
+		}
+	}
+
+	TEST(EscapeTests, EscapeArgumentExamples)
+	{
+		EXPECT_EQ(L"\"\"", hlp::EscapeArgument(L""));
+		EXPECT_EQ(L"c:\\dir\\", hlp::EscapeArgument(L"c:\\dir\\"));
+		EXPECT_EQ(L"\"c:\\my dir\\\\\"", hlp::EscapeArgument(L"c:\\my dir\\"));
+		EXPECT_EQ(L"\"a\\\\\\\"b\"", hlp::EscapeArgument(L"a\\\"b"));
+	}
+
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Counts the allocations made through it before forwarding them to the new/delete resource.
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t count{ 0 };
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			++count;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	// Installs a counting resource as the default resource for the lifetime of the test.
+	class MemoryResourceTests : public testing::Test
+	{
+	protected:
+		CountingResource counter_{};
+		std::pmr::memory_resource* pPrevious_{ nullptr };
+
+		void SetUp() override
+		{
+			pPrevious_ = std::pmr::set_default_resource(&counter_);
+		}
+
+		void TearDown() override
+		{
+			std::pmr::set_default_resource(pPrevious_);
+		}
+	};
+
+	TEST_F(MemoryResourceTests, HotPathsDontUseTheDefaultResource)
+	{
+		// The arena has no upstream, so it throws instead of falling back to the heap.
+		alignas(std::max_align_t) BYTE buffer[16 * 1024];
+		std::pmr::monotonic_buffer_resource arena{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+
+		auto renamed{ hlp::RenamePath(L"c:\\dir\\file.txt", L"other.txt", &arena) };
+		EXPECT_EQ(std::wstring(renamed.begin(), renamed.end()), L"c:\\dir\\other.txt");
+
+		auto escaped{ hlp::EscapeBackslash(L"c:\\dir\\file.txt", &arena) };
+		EXPECT_EQ(std::wstring(escaped.begin(), escaped.end()), L"c:\\\\dir\\\\file.txt");
+
+		const std::wstring_view strings[]{ L"a", L"bc", L"def" };
+		auto joined{ hlp::JoinStrings(strings, L", ", &arena) };
+		EXPECT_EQ(std::wstring(joined.begin(), joined.end()), L"a, bc, def");
+
+		auto trimmed{ hlp::TrimString(L"  a b  ", L' ', &arena) };
+		EXPECT_EQ(std::wstring(trimmed.begin(), trimmed.end()), L"a b");
+
+		auto items{ hlp::GetMultiSzItems(L"a\0bc\0def\0", &arena) };
+		ASSERT_EQ(items.size(), 3u);
+		EXPECT_EQ(std::wstring(items[2].begin(), items[2].end()), L"def");
+
+		auto narrowItems{ hlp::GetMultiSzItems("a\0bc\0", &arena) };
+		ASSERT_EQ(narrowItems.size(), 2u);
+
+		auto wideItems{ hlp::GetMultiSzItemsWide("a\0bc\0", CP_ACP, &arena) };
+		ASSERT_EQ(wideItems.size(), 2u);
+		EXPECT_EQ(std::wstring(wideItems[1].begin(), wideItems[1].end()), L"bc");
+
+		auto wideStr{ hlp::WStrFromStr("abc", CP_ACP, &arena) };
+		EXPECT_EQ(std::wstring(wideStr.begin(), wideStr.end()), L"abc");
+
+		EXPECT_EQ(counter_.count, 0u);
+	}
+
+	TEST_F(MemoryResourceTests, MultiSzItemsAllocateTheVectorOnce)
+	{
+		// The items fit in the small string buffer, so the only allocation is the vector reserved for all of them.
+		CountingResource resource{};
+
+		EXPECT_EQ(5u, hlp::GetMultiSzItems("a\0b\0c\0d\0e\0", &resource).size());
+		EXPECT_EQ(1u, resource.count);
+
+		EXPECT_EQ(5u, hlp::GetMultiSzItemsWide("a\0b\0c\0d\0e\0", CP_ACP, &resource).size());
+		EXPECT_EQ(2u, resource.count);
+
+		EXPECT_EQ(5u, hlp::GetMultiSzItems(L"a\0b\0c\0d\0e\0", &resource).size());
+		EXPECT_EQ(3u, resource.count);
+	}
+
+	TEST_F(MemoryResourceTests, StringArenaAllocatesPerBlock)
+	{
+		std::wstring multiSz{};
+		for (int i{ 0 }; i < 200000; ++i)
+		{
+			multiSz += L"c:\\dir\\subdir\\file" + std::to_wstring(i) + L".txt";
+			multiSz += L'\0';
+		}
+
+		// About 90 blocks of 64K characters, plus the growth of the list of the strings.
+		CountingResource resource{};
+		{
+			hlp::StringArena items{ &resource };
+			hlp::GetMultiSzItems(multiSz.c_str(), items);
+			ASSERT_EQ(200000u, items.size());
+			EXPECT_EQ(L"c:\\dir\\subdir\\file199999.txt", items[199999]);
+			EXPECT_LT(resource.count, 200u);
+		}
+
+		// The strings don't fit in the small string buffer, so each one has its own allocation.
+		CountingResource strings{};
+		EXPECT_EQ(200000u, hlp::GetMultiSzItems(multiSz.c_str(), &strings).size());
+		EXPECT_GT(strings.count, 200000u);
+
+		EXPECT_EQ(counter_.count, 0u);
+	}
+
+	TEST_F(MemoryResourceTests, ChainedBuildAllocatesOnce)
+	{
+		// Long enough for the result not to fit in the small string buffer.
+		const std::wstring paths[]{ L"  c:\\program files\\application\\settings.ini  ", L"  c:\\users\\name\\report.docx  ", L"  d:\\backup.zip  " };
+
+		CountingResource resource{};
+		auto built{ hlp::BuildString([&paths](auto&& out)
+		{
+			return hlp::JoinStringsTo(paths, L";", out, [](std::wstring_view path, auto& itemOut)
+			{
+				return hlp::EscapeBackslashTo(hlp::TrimStringView(path, L' '), itemOut);
+			});
+		}, &resource) };
+
+		EXPECT_EQ(std::wstring(built.begin(), built.end()), L"c:\\\\program files\\\\application\\\\settings.ini;c:\\\\users\\\\name\\\\report.docx;d:\\\\backup.zip");
+		EXPECT_EQ(1u, resource.count);
+		EXPECT_EQ(counter_.count, 0u);
+	}
+
+	TEST_F(MemoryResourceTests, CounterSeesDefaultAllocations)
+	{
+		std::pmr::wstring str(100, L'x');
+		EXPECT_GT(counter_.count, 0u);
+	}
+
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Reference implementations, one strlen per item.
+
+	template <typename T>
+	size_t ReferenceLength(const T* pStr)
+	{
+		return std::char_traits<T>::length(pStr);
+	}
+
+	template <typename T>
+	size_t ReferenceCount(const T* pMultiSz)
+	{
+		size_t count{ 0 };
+		for (; *pMultiSz; pMultiSz += ReferenceLength(pMultiSz) + 1)
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	size_t ReferenceSize(const T* pMultiSz)
+	{
+		auto p{ pMultiSz };
+		for (; *p; p += ReferenceLength(p) + 1)
+		{
+		}
+
+		return static_cast<size_t>(p - pMultiSz + 1) * sizeof(T);
+	}
+
+	// Fills the buffer with a random multi-sz sequence starting at offset, followed by garbage.
+	template <typename T>
+	const T* BuildRandomMultiSz(std::vector<T>& buffer, size_t offset, std::mt19937& random)
+	{
+		std::uniform_int_distribution<size_t> itemCount{ 0, 80 };
+		std::uniform_int_distribution<size_t> itemLength{ 1, 40 };
+		std::uniform_int_distribution<int> chr{ 1, 127 };
+
+		buffer.assign(offset, T{ 'x' });
+		for (auto count{ itemCount(random) }; count != 0; --count)
+		{
+			for (auto length{ itemLength(random) }; length != 0; --length)
+			{
+				buffer.push_back(static_cast<T>(chr(random)));
+			}
+
+			buffer.push_back(0);
+		}
+
+		buffer.push_back(0);
+		buffer.insert(buffer.end(), 64, T{ 'x' });
+
+		return buffer.data() + offset;
+	}
+
+	template <typename T>
+	void CheckRandomMultiSz()
+	{
+		std::mt19937 random{ 2019 };
+		std::vector<T> buffer{};
+
+		for (int i{ 0 }; i < 2000; ++i)
+		{
+			auto pMultiSz{ BuildRandomMultiSz(buffer, static_cast<size_t>(i % 64), random) };
+
+			ASSERT_EQ(ReferenceCount(pMultiSz), hlp::GetMultiSzCount(pMultiSz)) << "iteration " << i;
+			ASSERT_EQ(ReferenceSize(pMultiSz), hlp::GetMultiSzSize(pMultiSz)) << "iteration " << i;
+			ASSERT_EQ(ReferenceCount(pMultiSz) > 1, hlp::IsMultiSzItems(pMultiSz)) << "iteration " << i;
+
+			hlp::MultiSzIndex<T> index{ pMultiSz };
+			ASSERT_EQ(ReferenceCount(pMultiSz), index.size()) << "iteration " << i;
+			ASSERT_EQ(ReferenceSize(pMultiSz), index.ByteSize()) << "iteration " << i;
+
+			auto pItem{ pMultiSz };
+			for (size_t item{ 0 }; item < index.size(); ++item)
+			{
+				ASSERT_EQ(std::basic_string_view<T>{ pItem }, index[item]) << "iteration " << i;
+				pItem += ReferenceLength(pItem) + 1;
+			}
+		}
+	}
+
+	TEST(MultiSzTests, NarrowScanMatchesReference)
+	{
+		CheckRandomMultiSz<char>();
+	}
+
+	TEST(MultiSzTests, WideScanMatchesReference)
+	{
+		CheckRandomMultiSz<WCHAR>();
+	}
+
+	TEST(MultiSzTests, EmptyAndNullSequences)
+	{
+		EXPECT_EQ(0u, hlp::GetMultiSzCount(static_cast<LPCWSTR>(nullptr)));
+		EXPECT_EQ(0u, hlp::GetMultiSzSize(static_cast<LPCSTR>(nullptr)));
+		EXPECT_EQ(0u, hlp::GetMultiSzCount(L"\0"));
+		EXPECT_EQ(sizeof(WCHAR), hlp::GetMultiSzSize(L"\0"));
+		EXPECT_FALSE(hlp::IsMultiSzItems("a\0"));
+		EXPECT_TRUE(hlp::IsMultiSzItems(L"a\0b\0"));
+		EXPECT_TRUE(hlp::MultiSzIndex<WCHAR>{ nullptr }.empty());
+		EXPECT_TRUE(hlp::MultiSzIndex<WCHAR>{ L"\0" }.empty());
+		EXPECT_EQ(sizeof(WCHAR), hlp::MultiSzIndex<WCHAR>{ L"\0" }.ByteSize());
+	}
+
+	TEST(MultiSzTests, ViewIteratesTheItems)
+	{
+		hlp::MultiSzView<WCHAR> view{ L"c:\\a.txt\0b\0c:\\dir\\c.txt\0" };
+		EXPECT_FALSE(view.empty());
+
+		std::vector<std::wstring_view> items{};
+		for (auto item : view)
+		{
+			items.push_back(item);
+		}
+
+		EXPECT_EQ((std::vector<std::wstring_view>{ L"c:\\a.txt", L"b", L"c:\\dir\\c.txt" }), items);
+		EXPECT_EQ(3, std::distance(view.begin(), view.end()));
+
+		auto it{ view.begin() };
+		EXPECT_EQ(L"c:\\a.txt", *it++);
+		EXPECT_EQ(1u, it->length());
+		EXPECT_EQ(view.end(), ++++it);
+
+		hlp::MultiSzView<char> narrowView{ "a\0bc\0" };
+		EXPECT_EQ((std::vector<std::string_view>{ "a", "bc" }), std::vector<std::string_view>(narrowView.begin(), narrowView.end()));
+	}
+
+	TEST(MultiSzTests, ViewOfEmptySequences)
+	{
+		hlp::MultiSzView<WCHAR> nullView{ nullptr };
+		EXPECT_TRUE(nullView.empty());
+		EXPECT_EQ(nullView.end(), nullView.begin());
+
+		hlp::MultiSzView<WCHAR> emptyView{ L"\0" };
+		EXPECT_TRUE(emptyView.empty());
+		EXPECT_EQ(emptyView.end(), emptyView.begin());
+	}
+
+	TEST(MultiSzTests, ViewWithoutFinalTerminator)
+	{
+		// A REG_MULTI_SZ value can miss its final terminator, the one of the std::wstring holding it ends the sequence.
+		std::wstring multiSz{ L"a\0bc\0", 5 };
+		hlp::MultiSzView<WCHAR> view{ multiSz.c_str() };
+		EXPECT_EQ((std::vector<std::wstring_view>{ L"a", L"bc" }), std::vector<std::wstring_view>(view.begin(), view.end()));
+
+		// The sequence ends at the first empty item, whatever follows it.
+		std::wstring buffer{ L"a\0\0garbage\0", 13 };
+		hlp::MultiSzView<WCHAR> bufferView{ buffer.c_str() };
+		EXPECT_EQ(1, std::distance(bufferView.begin(), bufferView.end()));
+	}
+
+	// Builds the sequence and reads it back.
+	template <typename Range>
+	std::vector<std::wstring> RoundTrip(const Range& items)
+	{
+		hlp::MultiSzBuilder<Range> builder{ items };
+		auto multiSz{ builder.Build() };
+
+		EXPECT_EQ(builder.Length(), multiSz.length() + 1);
+		EXPECT_EQ(builder.ByteSize(), hlp::GetMultiSzSize(multiSz.c_str()));
+
+		return hlp::GetMultiSzItems(multiSz.c_str());
+	}
+
+	TEST(MultiSzTests, BuilderRoundTrip)
+	{
+		// No item, or only empty items, gives an empty sequence.
+		EXPECT_TRUE(RoundTrip(std::vector<std::wstring>{}).empty());
+		EXPECT_TRUE(RoundTrip(std::vector<std::wstring>{ L"", L"" }).empty());
+		EXPECT_EQ(1u, hlp::MultiSzBuilder<std::vector<std::wstring>>{ std::vector<std::wstring>{ L"" } }.Length());
+
+		EXPECT_EQ((std::vector<std::wstring>{ L"c:\\a.txt" }), RoundTrip(std::vector<LPCWSTR>{ L"c:\\a.txt" }));
+
+		// Empty items are skipped since they would end the sequence.
+		EXPECT_EQ((std::vector<std::wstring>{ L"a", L"bc" }), RoundTrip(std::vector<std::wstring_view>{ L"", L"a", L"", L"bc", L"" }));
+
+		// Long paths (up to the 32767 characters of the \\?\ prefix), crossing many blocks of the scan.
+		std::vector<std::wstring> paths{};
+		for (size_t length : { 259, 260, 261, 4096, 32767 })
+		{
+			auto path{ L"\\\\?\\c:\\" + std::wstring(length - 7, L'd') };
+			path[length - 1] = L'x';
+			paths.push_back(path);
+		}
+
+		EXPECT_EQ(paths, RoundTrip(paths));
+	}
+
+	TEST(MultiSzTests, BuilderWritesOnlyIntoLargeEnoughBuffers)
+	{
+		std::vector<std::wstring> items{ L"a", L"bc" };
+		hlp::MultiSzBuilder<std::vector<std::wstring>> builder{ items };
+		ASSERT_EQ(6u, builder.Length());
+
+		std::vector<WCHAR> buffer(6, L'x');
+		EXPECT_EQ(0u, builder.Write(buffer.data(), 5));
+		EXPECT_EQ(L'x', buffer[0]);
+		EXPECT_EQ(6u, builder.Write(buffer.data(), buffer.size()));
+		EXPECT_EQ((std::vector<std::wstring>{ L"a", L"bc" }), hlp::GetMultiSzItems(buffer.data()));
+
+		std::vector<BYTE> dropFiles(builder.DropFilesSize());
+		EXPECT_EQ(0u, builder.WriteDropFiles(dropFiles.data(), dropFiles.size() - 1));
+		EXPECT_EQ(dropFiles.size(), builder.WriteDropFiles(dropFiles.data(), dropFiles.size()));
+		EXPECT_EQ(dropFiles, builder.BuildDropFiles());
+	}
+
+}
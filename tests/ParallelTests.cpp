@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	TEST(ParallelTests, ResultsAreConsumedInOrder)
+	{
+		std::vector<size_t> consumed{};
+		hlp::ParallelOptions options{};
+		options.threadCount = 4;
+		options.maxInFlight = 3;
+
+		auto completed{ hlp::ParallelForEachOrdered(1000, [](size_t index) { return index * 2; },
+			[&consumed](size_t index, size_t result) { EXPECT_EQ(index * 2, result); consumed.push_back(index); }, options) };
+
+		EXPECT_TRUE(completed);
+		ASSERT_EQ(1000u, consumed.size());
+		for (size_t i{ 0 }; i < consumed.size(); ++i)
+		{
+			EXPECT_EQ(i, consumed[i]);
+		}
+	}
+
+	TEST(ParallelTests, WorkersOverlapWithinTheWindow)
+	{
+		std::atomic<size_t> active{ 0 };
+		std::atomic<size_t> peak{ 0 };
+		hlp::ParallelOptions options{};
+		options.threadCount = 4;
+		options.maxInFlight = 4;
+
+		// The items of the first window must be transformed concurrently, the sleep lets them overlap even on a single core.
+		hlp::ParallelForEachOrdered(64, [&](size_t index)
+		{
+			if (index < options.maxInFlight)
+			{
+				auto current{ ++active };
+				auto previous{ peak.load() };
+				while (previous < current && !peak.compare_exchange_weak(previous, current))
+				{
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+				--active;
+			}
+
+			return index;
+		}, [](size_t, size_t) {}, options);
+
+		EXPECT_GT(peak.load(), 1u);
+	}
+
+	TEST(ParallelTests, CallsReuseThePoolThreads)
+	{
+		std::mutex mutex{};
+		std::set<std::thread::id> threads{};
+		hlp::ParallelOptions options{};
+		options.threadCount = 4;
+
+		for (int call{ 0 }; call < 20; ++call)
+		{
+			hlp::ParallelForEachOrdered(64, [&](size_t index)
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				threads.insert(std::this_thread::get_id());
+				return index;
+			}, [](size_t, size_t) {}, options);
+		}
+
+		// The threads left by the previous tests can be reused too, but no call creates its own.
+		EXPECT_LE(threads.size(), 8u);
+	}
+
+	TEST(ParallelTests, PoolIsCappedAtTheProcessorCount)
+	{
+		std::mutex mutex{};
+		std::set<std::thread::id> threads{};
+		hlp::ParallelOptions options{};
+		options.threadCount = 64;
+
+		hlp::ParallelForEachOrdered(256, [&](size_t index)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+			std::lock_guard<std::mutex> lock{ mutex };
+			threads.insert(std::this_thread::get_id());
+			return index;
+		}, [](size_t, size_t) {}, options);
+
+		// The pool threads and the calling thread.
+		EXPECT_LE(threads.size(), (std::max)(std::thread::hardware_concurrency(), 1u) + 1);
+	}
+
+	TEST(ParallelTests, NestedCallsDontDeadlock)
+	{
+		hlp::ParallelOptions options{};
+		options.threadCount = 2;
+
+		size_t total{ 0 };
+		hlp::ParallelForEachOrdered(4, [&options](size_t)
+		{
+			size_t sum{ 0 };
+			hlp::ParallelForEachOrdered(10, [](size_t index) { return index; }, [&sum](size_t, size_t result) { sum += result; }, options);
+			return sum;
+		}, [&total](size_t, size_t result) { total += result; }, options);
+
+		EXPECT_EQ(4u * 45u, total);
+	}
+
+	TEST(ParallelTests, CancellationAndExceptions)
+	{
+		std::atomic<bool> cancel{ false };
+		hlp::ParallelOptions options{};
+		options.threadCount = 2;
+		options.pCancel = &cancel;
+
+		size_t consumed{ 0 };
+		auto completed{ hlp::ParallelForEachOrdered(1000, [](size_t index) { return index; },
+			[&](size_t index, size_t) { ++consumed; if (index == 10) { cancel = true; } }, options) };
+
+		EXPECT_FALSE(completed);
+		EXPECT_EQ(11u, consumed);
+
+		options.pCancel = nullptr;
+		EXPECT_THROW(hlp::ParallelForEachOrdered(100, [](size_t index)
+		{
+			if (index == 50)
+			{
+				throw std::runtime_error{ "transform" };
+			}
+
+			return index;
+		}, [](size_t, size_t) {}, options), std::runtime_error);
+	}
+
+}
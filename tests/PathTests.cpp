@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Naive normalization by passes over a list of components, the root being given by the caller.
+	std::wstring ReferenceNormalizePath(std::wstring path, size_t rootLength)
+	{
+		std::replace(path.begin(), path.end(), L'/', L'\\');
+
+		auto root{ path.substr(0, rootLength) };
+		auto rooted{ rootLength != 0 && !(rootLength == 2 && root[1] == L':') };
+
+		// Each component keeps its position so the last one can be found once the others are removed.
+		std::vector<std::pair<std::wstring, size_t>> components{};
+		size_t start{ rootLength };
+		while (start <= path.length() && rootLength != path.length())
+		{
+			auto end{ (std::min)(path.find(L'\\', start), path.length()) };
+			components.emplace_back(path.substr(start, end - start), components.size());
+			start = end + 1;
+		}
+
+		auto lastIndex{ components.size() - 1 };
+		auto lastName{ components.empty() ? std::wstring{} : components.back().first };
+
+		components.erase(std::remove_if(components.begin(), components.end(),
+			[](const auto& component) { return component.first.empty() || component.first == L"."; }), components.end());
+
+		for (auto removed{ true }; removed; )
+		{
+			removed = false;
+			for (size_t i{ 1 }; i < components.size(); ++i)
+			{
+				if (components[i].first == L".." && components[i - 1].first != L"..")
+				{
+					components.erase(components.begin() + i - 1, components.begin() + i + 1);
+					removed = true;
+					break;
+				}
+			}
+		}
+
+		while (rooted && !components.empty() && components.front().first == L"..")
+		{
+			components.erase(components.begin());
+		}
+
+		auto lastKept{ !components.empty() && components.back().second == lastIndex };
+		auto directory{ lastName.empty() || lastName == L"." || (lastName == L".." && !lastKept) };
+
+		auto result{ root };
+		for (size_t i{ 0 }; i < components.size(); ++i)
+		{
+			result += (i != 0 ? L"\\" : L"") + components[i].first;
+		}
+
+		if (directory && !components.empty())
+		{
+			result += L'\\';
+		}
+
+		if (result.empty() && !path.empty())
+		{
+			result = L".";
+		}
+
+		return result;
+	}
+
+	// Returns : Random path made of a root and of components that matter to the normalization.
+	std::pair<std::wstring, size_t> BuildRandomPath(std::mt19937& random)
+	{
+		static const WCHAR* ROOTS[]{ L"", L"c:", L"c:\\", L"\\", L"\\\\server\\share\\", L"\\\\?\\c:\\" };
+		static const WCHAR* COMPONENTS[]{ L"a", L"bc", L"...", L".x", L"", L".", L".." };
+		std::uniform_int_distribution<size_t> root{ 0, std::size(ROOTS) - 1 };
+		std::uniform_int_distribution<size_t> component{ 0, std::size(COMPONENTS) - 1 };
+		std::uniform_int_distribution<size_t> componentCount{ 0, 8 };
+		std::bernoulli_distribution slash{ 0.3 };
+
+		std::wstring path{ ROOTS[root(random)] };
+		auto rootLength{ path.length() };
+		auto count{ componentCount(random) };
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			// The first component isn't empty so the separators don't change the root.
+			std::wstring_view name{ COMPONENTS[component(random)] };
+			while (i == 0 && name.empty())
+			{
+				name = COMPONENTS[component(random)];
+			}
+
+			if (i != 0)
+			{
+				path += slash(random) ? L'/' : L'\\';
+			}
+
+			path += name;
+		}
+
+		for (size_t i{ 0 }; i < rootLength; ++i)
+		{
+			if (path[i] == L'\\' && slash(random))
+			{
+				path[i] = L'/';
+			}
+		}
+
+		return { path, rootLength };
+	}
+
+	TEST(PathTests, NormalizePath)
+	{
+		EXPECT_EQ(L"c:\\a\\c", hlp::NormalizePath(L"c:/a/./b/../c"));
+		EXPECT_EQ(L"c:\\a\\", hlp::NormalizePath(L"c:\\a\\\\b\\..\\"));
+		EXPECT_EQ(L"c:\\", hlp::NormalizePath(L"c:\\..\\.."));
+		EXPECT_EQ(L"\\\\server\\share\\b", hlp::NormalizePath(L"\\\\server\\share\\a\\..\\..\\b"));
+		EXPECT_EQ(L".", hlp::NormalizePath(L"a\\.."));
+		EXPECT_EQ(L"..\\a", hlp::NormalizePath(L"..\\a"));
+	}
+
+	TEST(PathTests, NormalizePathMatchesReference)
+	{
+		std::mt19937 random{ 2019 };
+
+		for (int i{ 0 }; i < 50000; ++i)
+		{
+			auto [path, rootLength] { BuildRandomPath(random) };
+			ASSERT_EQ(ReferenceNormalizePath(path, rootLength), hlp::NormalizePath(path));
+		}
+	}
+
+	TEST(PathTests, NormalizePathLongPathPrefix)
+	{
+		std::wstring longPath{ L"c:\\" + std::wstring(300, L'a') };
+
+		EXPECT_EQ(L"\\\\?\\" + longPath, hlp::NormalizePath(longPath, hlp::LongPathPrefix::Add));
+		EXPECT_EQ(L"c:\\a", hlp::NormalizePath(L"\\\\?\\c:\\a", hlp::LongPathPrefix::Remove));
+		EXPECT_EQ(L"\\\\server\\share", hlp::NormalizePath(L"\\\\?\\unc\\server\\share", hlp::LongPathPrefix::Remove));
+		EXPECT_EQ(L"\\\\?\\c:\\a", hlp::NormalizePath(L"\\\\?\\c:\\a", hlp::LongPathPrefix::Keep));
+	}
+
+	TEST(PathTests, PathView)
+	{
+		hlp::PathView path{ L"c:\\dir\\\\file.tar.gz" };
+
+		std::vector<std::wstring> components{};
+		for (auto component : path)
+		{
+			components.emplace_back(component);
+		}
+
+		EXPECT_EQ((std::vector<std::wstring>{ L"dir", L"file.tar.gz" }), components);
+		EXPECT_EQ(L"c:\\", path.Root());
+		EXPECT_EQ(L"c:\\dir", path.Parent());
+		EXPECT_EQ(L"file.tar", path.Stem());
+		EXPECT_EQ(L".gz", path.Extension());
+	}
+
+	TEST(PathTests, RenamePath)
+	{
+		EXPECT_EQ(L"c:\\dir\\new.txt", hlp::RenamePath(L"c:\\dir\\old.txt", L"new.txt"));
+
+		// Same output as the original implementation: everything up to the last backslash is kept.
+		EXPECT_EQ(L"c:\\dir\\", hlp::RenamePath(L"c:\\dir\\old.txt", L""));
+		EXPECT_EQ(L"c:\\dir\\\\new.txt", hlp::RenamePath(L"c:\\dir\\\\old.txt", L"new.txt"));
+		EXPECT_EQ(L"\\\\server\\x", hlp::RenamePath(L"\\\\server\\share", L"x"));
+		EXPECT_EQ(L"new.txt", hlp::RenamePath(L"old.txt", L"new.txt"));
+	}
+
+	TEST(PathTests, PathBuilder)
+	{
+		EXPECT_EQ(L"c:\\dir\\file.txt", (hlp::PathBuilder{ L"c:\\dir", L"", L"\\\\file.txt" }.Build()));
+		EXPECT_EQ(L"c:\\file.txt", (hlp::PathBuilder{ L"c:\\", L"file.txt" }.Build()));
+		EXPECT_EQ(L"c:\\dir\\\\file.txt", (hlp::PathBuilder{ L"c:\\dir\\\\", L"file.txt" }.Build()));
+	}
+
+}
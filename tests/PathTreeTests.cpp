@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Returns : Paths of the items under the prefix, in the order ForEachItem gives them.
+	std::vector<std::wstring> GetItems(const hlp::PathTree& tree, std::wstring_view prefix)
+	{
+		std::vector<std::wstring> items{};
+		tree.ForEachItem(prefix, [&items](std::wstring_view path) { items.emplace_back(path); });
+
+		return items;
+	}
+
+	TEST(PathTreeTests, AddAndLookup)
+	{
+		hlp::PathTree tree{};
+
+		EXPECT_TRUE(tree.Add(L"c:\\dir\\a.txt"));
+		EXPECT_TRUE(tree.Add(L"c:\\dir\\b.txt"));
+		EXPECT_TRUE(tree.Add(L"c:\\dir\\sub\\c.txt"));
+		EXPECT_TRUE(tree.Add(L"\\\\server\\share\\d.txt"));
+		EXPECT_FALSE(tree.Add(L"c:\\dir\\a.txt"));
+		EXPECT_FALSE(tree.Add(L""));
+		EXPECT_EQ(4u, tree.size());
+
+		EXPECT_TRUE(tree.Contains(L"c:\\dir\\a.txt"));
+		EXPECT_TRUE(tree.Contains(L"\\\\server\\share\\d.txt"));
+		EXPECT_FALSE(tree.Contains(L"c:\\dir"));
+		EXPECT_FALSE(tree.Contains(L"c:\\dir\\d.txt"));
+
+		// A directory is found as a node without being an item.
+		auto dir{ tree.Find(L"c:\\dir") };
+		ASSERT_NE(hlp::PathTree::NO_NODE, dir);
+		EXPECT_FALSE(tree.IsItem(dir));
+		EXPECT_EQ(L"dir", tree.GetName(dir));
+		EXPECT_EQ(L"c:\\", tree.GetName(tree.GetParent(dir)));
+		EXPECT_EQ(hlp::PathTree::NO_NODE, tree.Find(L"d:\\dir"));
+
+		std::wstring path{};
+		tree.GetPath(tree.Find(L"c:\\dir\\sub\\c.txt"), path);
+		EXPECT_EQ(L"c:\\dir\\sub\\c.txt", path);
+	}
+
+	TEST(PathTreeTests, ChildrenKeepTheirOrder)
+	{
+		hlp::PathTree tree{};
+		tree.Add(L"c:\\dir\\b.txt");
+		tree.Add(L"c:\\dir\\a.txt");
+		tree.Add(L"c:\\dir\\c.txt");
+
+		std::vector<std::wstring_view> names{};
+		for (auto child{ tree.GetFirstChild(tree.Find(L"c:\\dir")) }; child != hlp::PathTree::NO_NODE; child = tree.GetNextSibling(child))
+		{
+			names.push_back(tree.GetName(child));
+		}
+
+		EXPECT_EQ((std::vector<std::wstring_view>{ L"b.txt", L"a.txt", L"c.txt" }), names);
+	}
+
+	TEST(PathTreeTests, PrefixEnumeration)
+	{
+		hlp::PathTree tree{};
+		tree.Add(L"c:\\dir");
+		tree.Add(L"c:\\dir\\a.txt");
+		tree.Add(L"c:\\dir\\sub\\b.txt");
+		tree.Add(L"c:\\dir2\\c.txt");
+		tree.Add(L"d:\\e.txt");
+
+		// The prefix is matched by component, so "c:\\dir" doesn't take the items of "c:\\dir2".
+		EXPECT_EQ((std::vector<std::wstring>{ L"c:\\dir", L"c:\\dir\\a.txt", L"c:\\dir\\sub\\b.txt" }), GetItems(tree, L"c:\\dir"));
+		EXPECT_EQ((std::vector<std::wstring>{ L"c:\\dir\\sub\\b.txt" }), GetItems(tree, L"c:\\dir\\sub"));
+		EXPECT_EQ(5u, GetItems(tree, L"").size());
+		EXPECT_TRUE(GetItems(tree, L"c:\\other").empty());
+
+		std::vector<std::pair<std::wstring, size_t>> directories{};
+		tree.ForEachDirectory([&directories](std::wstring_view path, const std::vector<std::wstring_view>& names)
+		{
+			directories.emplace_back(path, names.size());
+		});
+
+		// "c:\\dir" is an item of "c:\\".
+		ASSERT_EQ(5u, directories.size());
+		EXPECT_EQ((std::pair<std::wstring, size_t>{ L"c:\\", 1 }), directories[0]);
+		EXPECT_EQ((std::pair<std::wstring, size_t>{ L"c:\\dir", 1 }), directories[1]);
+		EXPECT_EQ((std::pair<std::wstring, size_t>{ L"d:\\", 1 }), directories[4]);
+	}
+
+	TEST(PathTreeTests, LoadMultiSz)
+	{
+		hlp::PathTree tree{};
+		EXPECT_EQ(2u, tree.Load(L"c:\\a.txt\0c:\\b.txt\0c:\\a.txt\0"));
+		EXPECT_EQ(0u, tree.Load(nullptr));
+		EXPECT_EQ(2u, tree.size());
+
+		tree.Clear();
+		EXPECT_EQ(0u, tree.size());
+		EXPECT_FALSE(tree.Contains(L"c:\\a.txt"));
+		EXPECT_TRUE(tree.Add(L"c:\\a.txt"));
+	}
+
+	TEST(PathTreeTests, HashTableGrows)
+	{
+		hlp::PathTree tree{};
+		std::set<std::wstring> paths{};
+
+		// Enough directories and items to resize the table several times.
+		for (int dir{ 0 }; dir < 200; ++dir)
+		{
+			for (int file{ 0 }; file < 100; ++file)
+			{
+				auto path{ L"c:\\dir" + std::to_wstring(dir) + L"\\file" + std::to_wstring(file) + L".txt" };
+				EXPECT_TRUE(tree.Add(path));
+				paths.insert(path);
+			}
+		}
+
+		EXPECT_EQ(paths.size(), tree.size());
+		EXPECT_EQ(1u + 1u + 200u + 200u * 100u, tree.GetNodeCount());
+
+		for (const auto& path : paths)
+		{
+			ASSERT_TRUE(tree.Contains(path));
+		}
+
+		auto items{ GetItems(tree, L"") };
+		EXPECT_EQ(paths, std::set<std::wstring>(items.begin(), items.end()));
+		EXPECT_GT(tree.GetMemoryUsage(), 0u);
+	}
+
+	TEST(PathTreeTests, ComponentsAreComparedOrdinally)
+	{
+		hlp::PathTree tree{};
+		EXPECT_TRUE(tree.Add(L"c:\\Dir\\File.txt"));
+		EXPECT_TRUE(tree.Add(L"c:\\dir\\file.txt"));
+		EXPECT_TRUE(tree.Add(L"C:\\dir\\file.txt"));
+		EXPECT_EQ(3u, tree.size());
+
+		EXPECT_TRUE(tree.Contains(L"c:\\Dir\\File.txt"));
+		EXPECT_FALSE(tree.Contains(L"c:\\DIR\\FILE.TXT"));
+		EXPECT_NE(tree.Find(L"c:\\Dir"), tree.Find(L"c:\\dir"));
+	}
+
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Returns : Statistics of the probe or nullptr if it has not recorded any duration.
+	const hlp::ProfilerStats* FindStats(const std::vector<hlp::ProfilerStats>& stats, const hlp::ProfilerProbe& probe)
+	{
+		auto it{ std::find_if(stats.begin(), stats.end(), [&probe](const auto& item) { return item.pName == probe.GetName(); }) };
+
+		return it != stats.end() ? &*it : nullptr;
+	}
+
+	TEST(ProfilerTests, TscClockFollowsSteadyClock)
+	{
+		// The first read measures the calibration.
+		auto start{ hlp::TscClock::now() };
+		auto steadyStart{ std::chrono::steady_clock::now() };
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+		auto elapsed{ hlp::TscClock::now() - start };
+		auto steadyElapsed{ std::chrono::steady_clock::now() - steadyStart };
+
+		EXPECT_NEAR(static_cast<double>(steadyElapsed.count()), static_cast<double>(elapsed.count()), steadyElapsed.count() * 0.05);
+	}
+
+	TEST(ProfilerTests, ScopeRecordsItsDuration)
+	{
+		static hlp::ProfilerProbe probe{ L"ProfilerTests.Scope" };
+		hlp::ResetProfiler();
+
+		for (int i{ 0 }; i < 3; ++i)
+		{
+			hlp::ProfilerScope scope{ probe };
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+		}
+
+		// A disabled profiler records nothing.
+		hlp::SetProfilerEnabled(false);
+		{
+			hlp::ProfilerScope scope{ probe };
+		}
+		hlp::SetProfilerEnabled(true);
+
+		auto stats{ hlp::GetProfilerStats() };
+		auto pStats{ FindStats(stats, probe) };
+		ASSERT_NE(nullptr, pStats);
+		EXPECT_EQ(3u, pStats->count);
+		// The buckets are about 1.6% wide.
+		EXPECT_GE(pStats->p50, 1900000u);
+		EXPECT_LT(pStats->p50, 1000000000u);
+		EXPECT_GE(pStats->max, pStats->p50);
+	}
+
+	TEST(ProfilerTests, ExitedThreadsAreStillReported)
+	{
+		static hlp::ProfilerProbe probe{ L"ProfilerTests.Exited" };
+		hlp::ResetProfiler();
+
+		for (int round{ 0 }; round < 10; ++round)
+		{
+			std::thread thread{ []()
+			{
+				for (int i{ 0 }; i < 100; ++i)
+				{
+					probe.Record(std::chrono::nanoseconds{ 100 });
+				}
+			} };
+			thread.join();
+		}
+
+		probe.Record(std::chrono::nanoseconds{ 1000 });
+
+		auto stats{ hlp::GetProfilerStats() };
+		auto pStats{ FindStats(stats, probe) };
+		ASSERT_NE(nullptr, pStats);
+		EXPECT_EQ(1001u, pStats->count);
+		EXPECT_EQ(100u, pStats->p50);
+		EXPECT_EQ((1000u * 100u + 1000u) / 1001u, pStats->mean);
+	}
+
+	TEST(ProfilerTests, ResetClearsTheExitedThreads)
+	{
+		static hlp::ProfilerProbe probe{ L"ProfilerTests.Reset" };
+
+		std::thread{ []() { probe.Record(std::chrono::nanoseconds{ 10 }); } }.join();
+		ASSERT_NE(nullptr, FindStats(hlp::GetProfilerStats(), probe));
+
+		hlp::ResetProfiler();
+		EXPECT_EQ(nullptr, FindStats(hlp::GetProfilerStats(), probe));
+	}
+
+}
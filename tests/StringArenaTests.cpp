@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	TEST(StringArenaTests, StringsAreAlignedAndTerminated)
+	{
+		hlp::StringArena arena{};
+		const std::wstring_view strings[]{ L"", L"a", L"bc", L"def", L"ghij" };
+
+		for (auto str : strings)
+		{
+			auto stored{ arena.Add(str) };
+			EXPECT_EQ(str, stored);
+			EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stored.data()) % alignof(WCHAR));
+			EXPECT_EQ(L'\0', stored.data()[stored.length()]);
+		}
+
+		ASSERT_EQ(std::size(strings), arena.size());
+		EXPECT_EQ(L"def", arena[3]);
+	}
+
+	TEST(StringArenaTests, ViewsSurviveTheGrowth)
+	{
+		hlp::StringArena arena{};
+		std::wstring str(1000, L'x');
+		std::vector<std::wstring_view> views{};
+
+		// Several blocks of 64K characters, then a string longer than a block.
+		for (int i{ 0 }; i < 300; ++i)
+		{
+			str[0] = static_cast<WCHAR>(L'a' + i % 26);
+			views.push_back(arena.Add(str));
+		}
+
+		std::wstring longStr(100000, L'y');
+		auto longView{ arena.Add(longStr) };
+		auto next{ arena.Add(L"next") };
+
+		for (int i{ 0 }; i < 300; ++i)
+		{
+			ASSERT_EQ(static_cast<WCHAR>(L'a' + i % 26), views[i][0]);
+			ASSERT_EQ(1000u, views[i].length());
+		}
+
+		EXPECT_EQ(longStr, longView);
+		EXPECT_EQ(L"next", next);
+		EXPECT_EQ(302u, arena.size());
+	}
+
+	TEST(StringArenaTests, ReserveAndCommit)
+	{
+		hlp::StringArena arena{};
+		auto pBuffer{ arena.Reserve(10) };
+		std::wstring_view{ L"abc" }.copy(pBuffer, 3);
+
+		EXPECT_EQ(L"abc", arena.Commit(3));
+		EXPECT_EQ(L"de", arena.Add(L"de"));
+		EXPECT_EQ(L"abc", arena[0]);
+	}
+
+	TEST(StringArenaTests, TruncateAndClear)
+	{
+		hlp::StringArena arena{};
+		arena.Add(L"a");
+		arena.Add(L"b");
+		arena.Add(L"c");
+
+		arena.Truncate(1);
+		ASSERT_EQ(1u, arena.size());
+		EXPECT_EQ(L"a", arena[0]);
+		arena.Truncate(5);
+		EXPECT_EQ(1u, arena.size());
+
+		arena.Clear();
+		EXPECT_TRUE(arena.empty());
+
+		// The arena can be filled again after Clear.
+		EXPECT_EQ(L"d", arena.Add(L"d"));
+		EXPECT_EQ(1u, arena.size());
+	}
+
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	TEST(StringTests, WidenStringCoversBlocksAndTail)
+	{
+		std::string str{};
+		for (int i{ 0 }; i < 100; ++i)
+		{
+			str += static_cast<char>(0x20 + i);
+		}
+
+		for (size_t length : { 0, 1, 15, 16, 17, 31, 32, 33, 100 })
+		{
+			std::wstring wideStr(length, L'\0');
+			hlp::WidenString(str.data(), length, &wideStr[0]);
+
+			for (size_t i{ 0 }; i < length; ++i)
+			{
+				ASSERT_EQ(static_cast<unsigned char>(str[i]), static_cast<unsigned>(wideStr[i])) << "length " << length << " index " << i;
+			}
+		}
+	}
+
+	// The char16_t overloads run the 16-bit code paths even where WCHAR is 32 bits.
+	TEST(StringTests, WidenStringToUtf16)
+	{
+		std::string str{};
+		for (int i{ 0 }; i < 100; ++i)
+		{
+			str += static_cast<char>(0x80 + i);
+		}
+
+		for (size_t length : { 0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100 })
+		{
+			std::u16string utf16Str(length, u'\0');
+			hlp::WidenString(str.data(), length, &utf16Str[0]);
+
+			for (size_t i{ 0 }; i < length; ++i)
+			{
+				ASSERT_EQ(static_cast<unsigned char>(str[i]), static_cast<unsigned>(utf16Str[i])) << "length " << length << " index " << i;
+			}
+		}
+	}
+
+	TEST(StringTests, WStrFromStrWidensLatin1)
+	{
+		EXPECT_EQ(L"abc\u00E9\u00FF", hlp::WStrFromStr("abc\xE9\xFF"));
+		EXPECT_EQ(L"", hlp::WStrFromStr(""));
+	}
+
+	TEST(StringTests, Utf8RoundTrip)
+	{
+		std::wstring str{ L"ascii only text over a few blocks, then \u00E9\u4E2D\u20AC and more ascii \U0001F600" };
+
+		auto utf8{ hlp::Utf16ToUtf8(str) };
+		EXPECT_TRUE(hlp::IsValidUtf8(utf8));
+		EXPECT_EQ(str, hlp::Utf8ToUtf16(utf8));
+		EXPECT_EQ(std::string{ "\xF0\x9F\x98\x80" }, utf8.substr(utf8.length() - 4));
+	}
+
+	TEST(StringTests, Utf16ToUtf8FromChar16)
+	{
+		std::u16string str{ u"ascii only text over a few blocks, then \u00E9\u4E2D\u20AC and more ascii \U0001F600" };
+		std::wstring wideStr{ L"ascii only text over a few blocks, then \u00E9\u4E2D\u20AC and more ascii \U0001F600" };
+
+		EXPECT_EQ(hlp::Utf16ToUtf8(wideStr), hlp::Utf16ToUtf8(str));
+
+		// Unpaired surrogates, inside and after the ASCII blocks.
+		EXPECT_EQ(std::string{ "abcdefgh\xEF\xBF\xBDx\xEF\xBF\xBD" }, hlp::Utf16ToUtf8(std::u16string{ u"abcdefgh\xDC00x\xD800" }));
+	}
+
+	TEST(StringTests, Utf8ToUtf16ReplacesInvalidSequences)
+	{
+		EXPECT_FALSE(hlp::IsValidUtf8("a\xC0\x80"));
+		EXPECT_EQ(L"a\uFFFD\uFFFDb", hlp::Utf8ToUtf16("a\xC0\x80" "b"));
+		EXPECT_EQ(L"a\uFFFD", hlp::Utf8ToUtf16("a\xE2\x82"));
+	}
+
+	TEST(StringTests, Utf8DecoderJoinsChunks)
+	{
+		std::string utf8{ "\xE2\x82\xAC" "x" "\xF0\x9F\x98\x80" };
+		std::wstring decoded{};
+
+		hlp::Utf8Decoder decoder{};
+		for (auto chr : utf8)
+		{
+			WCHAR buffer[hlp::Utf8Decoder::GetMaxLength(1)];
+			decoded.append(buffer, decoder.Decode(std::string_view{ &chr, 1 }, buffer));
+		}
+
+		EXPECT_EQ(hlp::Utf8ToUtf16(utf8), decoded);
+	}
+
+	TEST(StringTests, GetMultiSzItems)
+	{
+		auto multiSz{ hlp::MakeMultiSz(L"a", L"bc", L"def") };
+
+		EXPECT_EQ(3u, hlp::GetMultiSzCount(multiSz.c_str()));
+		EXPECT_EQ(multiSz.ByteSize(), hlp::GetMultiSzSize(multiSz.c_str()));
+		EXPECT_EQ((std::vector<std::wstring>{ L"a", L"bc", L"def" }), hlp::GetMultiSzItems(multiSz.c_str()));
+		EXPECT_EQ((std::vector<std::string>{ "a", "bc" }), hlp::GetMultiSzItems("a\0bc\0"));
+	}
+
+	TEST(StringTests, TrimString)
+	{
+		EXPECT_EQ(L"a b", hlp::TrimString(L" \t a b \r\n", hlp::WHITESPACE));
+		EXPECT_EQ(L"xa", hlp::TrimStringBack(L"xaxx", L'x'));
+		EXPECT_EQ(L"", hlp::TrimStringFront(L"xxxxxxxxxxxxxxxxxx", std::wstring_view{ L"x" }));
+	}
+
+	TEST(StringTests, TrimStringChar16)
+	{
+		// Long enough for the blocks of 8 characters, with the kept characters inside and outside the blocks.
+		std::u16string_view str{ u" \t \t \t \t \t a b c d e f g h i \r\n\r\n\r\n\r\n\r\n" };
+		std::u16string_view chars{ u" \t\r\n" };
+
+		EXPECT_EQ(u"a b c d e f g h i", hlp::TrimStringView(str, chars));
+		EXPECT_EQ(u"a b c d e f g h i \r\n\r\n\r\n\r\n\r\n", hlp::TrimStringFrontView(str, chars));
+		EXPECT_EQ(u" \t \t \t \t \t a b c d e f g h i", hlp::TrimStringBackView(str, chars));
+		EXPECT_TRUE(hlp::TrimStringView(u"xxxxxxxxxxxxxxxxxx", u"x").empty());
+		EXPECT_EQ(u"a", hlp::TrimStringBackView(u"axxxxxxxxxxxxxxxxxx", u"x"));
+	}
+
+}
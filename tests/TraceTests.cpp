@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "PortableHelpers.h"
+
+namespace
+{
+
+	// Returns : Count of occurrences of the pattern in the file.
+	size_t CountInFile(const char* pPath, std::string_view pattern)
+	{
+		std::ifstream file{ pPath, std::ios::binary };
+		std::stringstream content{};
+		content << file.rdbuf();
+		auto str{ content.str() };
+
+		size_t count{ 0 };
+		for (auto pos{ str.find(pattern) }; pos != std::string::npos; pos = str.find(pattern, pos + pattern.length()))
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	TEST(TraceTests, EventsOfExitedThreadsAreWritten)
+	{
+		ASSERT_TRUE(hlp::StartTrace(L"TraceTests.json"));
+
+		// The threads run one after the other, a buffer retired by one of them is reused once its events are written.
+		for (int round{ 0 }; round < 20; ++round)
+		{
+			std::thread{ []()
+			{
+				for (int i{ 0 }; i < 10; ++i)
+				{
+					hlp::RecordTraceEvent(L"TraceTests.Event", hlp::TraceEventType::Instant);
+				}
+			} }.join();
+		}
+
+		ASSERT_TRUE(hlp::StopTrace());
+		EXPECT_EQ(0u, hlp::GetTraceDroppedCount());
+		EXPECT_EQ(200u, CountInFile("TraceTests.json", "\"ph\":\"i\""));
+
+		std::remove("TraceTests.json");
+	}
+
+	TEST(TraceTests, StopWithoutStartFails)
+	{
+		EXPECT_FALSE(hlp::StopTrace());
+	}
+
+}
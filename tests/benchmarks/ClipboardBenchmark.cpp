@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+#include "PortableHelpers.h"
+
+// Text payloads of 1, 8 and 32 MB placed on the in-memory clipboard. The writer fills the clipboard block directly,
+// the copy builds the payload in a temporary buffer first as CopyToClipboard callers do. The last two place the
+// text, a drop list and a custom format under one open and with one transaction per format.
+
+namespace
+{
+
+	constexpr UINT FORMAT{ 0xC001 };
+
+	// Fills a text payload (a character pattern and the terminator).
+	void FillText(LPWSTR pText, size_t length)
+	{
+		for (size_t i{ 0 }; i < length; ++i)
+		{
+			pText[i] = static_cast<WCHAR>(L'a' + i % 26);
+		}
+
+		pText[length] = L'\0';
+	}
+
+	void BM_SetDataWriter(benchmark::State& state)
+	{
+		auto nBytes{ static_cast<SIZE_T>(state.range(0)) << 20 };
+		hlp::MemoryClipboardBackend backend{};
+
+		for (auto _ : state)
+		{
+			hlp::ClipboardTransaction transaction{ backend };
+			transaction.Open(nullptr);
+			transaction.SetData(CF_UNICODETEXT, nBytes, [](LPVOID pMem, SIZE_T nBytes_)
+			{
+				FillText(static_cast<LPWSTR>(pMem), nBytes_ / sizeof(WCHAR) - 1);
+				return true;
+			});
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nBytes));
+	}
+
+	void BM_SetDataCopy(benchmark::State& state)
+	{
+		auto nBytes{ static_cast<SIZE_T>(state.range(0)) << 20 };
+		hlp::MemoryClipboardBackend backend{};
+
+		for (auto _ : state)
+		{
+			std::vector<WCHAR> text(nBytes / sizeof(WCHAR));
+			FillText(text.data(), text.size() - 1);
+
+			hlp::ClipboardTransaction transaction{ backend };
+			transaction.Open(nullptr);
+			transaction.SetData(CF_UNICODETEXT, text.data(), nBytes);
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nBytes));
+	}
+
+	// formatsPerOpen : True to place the three formats under one open, false for one transaction each.
+	void SetThreeFormats(benchmark::State& state, bool formatsPerOpen)
+	{
+		auto nBytes{ static_cast<SIZE_T>(state.range(0)) << 20 };
+		hlp::MemoryClipboardBackend backend{};
+		auto dropFiles{ hlp::MultiSzBuilder{ std::vector<std::wstring>(1000, L"c:\\dir\\sub\\file.txt") }.BuildDropFiles() };
+		auto writer{ [](LPVOID pMem, SIZE_T nBytes_)
+		{
+			FillText(static_cast<LPWSTR>(pMem), nBytes_ / sizeof(WCHAR) - 1);
+			return true;
+		} };
+
+		for (auto _ : state)
+		{
+			hlp::ClipboardTransaction transaction{ backend };
+			transaction.Open(nullptr);
+			transaction.SetData(CF_UNICODETEXT, nBytes, writer);
+
+			if (!formatsPerOpen)
+			{
+				transaction.Close();
+				transaction.Open(nullptr);
+			}
+
+			transaction.SetData(CF_HDROP, dropFiles.data(), dropFiles.size());
+
+			if (!formatsPerOpen)
+			{
+				transaction.Close();
+				transaction.Open(nullptr);
+			}
+
+			transaction.SetData(FORMAT, nBytes, writer);
+		}
+
+		state.counters["opens"] = static_cast<double>(backend.GetOpenCount()) / static_cast<double>(state.iterations());
+		state.counters["formats"] = static_cast<double>(backend.GetFormatCount());
+	}
+
+	void BM_ThreeFormatsOneOpen(benchmark::State& state)
+	{
+		SetThreeFormats(state, true);
+	}
+
+	void BM_ThreeFormatsOneOpenEach(benchmark::State& state)
+	{
+		SetThreeFormats(state, false);
+	}
+
+}
+
+BENCHMARK(BM_SetDataWriter)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SetDataCopy)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ThreeFormatsOneOpen)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ThreeFormatsOneOpenEach)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "PortableHelpers.h"
+
+// Parsing of a command line by CommandLineArguments (views, unescaped arguments in a reused buffer)
+// and by a parser copying every argument into a std::wstring.
+
+namespace
+{
+
+	std::wstring BuildCommandLine(bool quoted)
+	{
+		std::vector<std::wstring> arguments{ L"c:\\program files\\app\\app.exe" };
+		for (int i{ 0 }; i < 100; ++i)
+		{
+			arguments.push_back(quoted ? L"c:\\dir with spaces\\file " + std::to_wstring(i) + L".txt" : L"c:\\dir\\file" + std::to_wstring(i) + L".txt");
+			arguments.push_back(L"/option:" + std::to_wstring(i));
+		}
+
+		return hlp::CommandLineBuilder{ arguments }.Build();
+	}
+
+	std::vector<std::wstring> CopyParse(std::wstring_view commandLine)
+	{
+		std::vector<std::wstring> arguments{};
+		auto isBlank{ [](WCHAR chr) { return chr == L' ' || chr == L'\t'; } };
+		size_t index{ 0 };
+
+		for (;;)
+		{
+			while (index < commandLine.length() && isBlank(commandLine[index]))
+			{
+				++index;
+			}
+
+			if (index == commandLine.length())
+			{
+				return arguments;
+			}
+
+			std::wstring argument{};
+			auto quoted{ false };
+
+			while (index < commandLine.length() && (quoted || !isBlank(commandLine[index])))
+			{
+				if (commandLine[index] == L'\\')
+				{
+					size_t backslashes{ 0 };
+					for (; index < commandLine.length() && commandLine[index] == L'\\'; ++index)
+					{
+						++backslashes;
+					}
+
+					if (index < commandLine.length() && commandLine[index] == L'"')
+					{
+						argument.append(backslashes / 2, L'\\');
+						if (backslashes % 2 != 0)
+						{
+							argument += L'"';
+							++index;
+						}
+					}
+					else
+					{
+						argument.append(backslashes, L'\\');
+					}
+				}
+				else if (commandLine[index] == L'"')
+				{
+					if (quoted && index + 1 < commandLine.length() && commandLine[index + 1] == L'"')
+					{
+						argument += L'"';
+						index += 2;
+					}
+					else
+					{
+						quoted = !quoted;
+						++index;
+					}
+				}
+				else
+				{
+					argument += commandLine[index++];
+				}
+			}
+
+			arguments.push_back(argument);
+		}
+	}
+
+	void BM_CommandLineArguments(benchmark::State& state)
+	{
+		auto commandLine{ BuildCommandLine(state.range(0) != 0) };
+		hlp::CommandLineArguments arguments{};
+
+		for (auto _ : state)
+		{
+			arguments.Load(commandLine);
+			benchmark::DoNotOptimize(arguments.size());
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * commandLine.length() * sizeof(WCHAR)));
+	}
+
+	void BM_CopyParse(benchmark::State& state)
+	{
+		auto commandLine{ BuildCommandLine(state.range(0) != 0) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(CopyParse(commandLine));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * commandLine.length() * sizeof(WCHAR)));
+	}
+
+}
+
+// Argument 0 : plain arguments, argument 1 : quoted arguments.
+BENCHMARK(BM_CommandLineArguments)->Arg(0)->Arg(1);
+BENCHMARK(BM_CopyParse)->Arg(0)->Arg(1);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "PortableHelpers.h"
+
+// Escaping of a 32 KB string full of UNC paths and quotes by the linear functions and by the previous inserts.
+
+namespace
+{
+
+	std::wstring BuildPathologicalString()
+	{
+		std::wstring str{};
+		while (str.length() < 32 * 1024)
+		{
+			str += L"\\\\server\\share\\dir with spaces\\\"quoted\\\\\" ";
+		}
+
+		return str;
+	}
+
+	std::wstring InsertEscapeBackslash(std::wstring str)
+	{
+		auto index{ str.length() };
+
+		while (--index != str.npos)
+		{
+			if (str[index] == L'\\')
+			{
+				str.insert(index, 1, L'\\');
+			}
+		}
+
+		return str;
+	}
+
+	std::wstring InsertEscapeArgument(std::wstring argument)
+	{
+		if (!argument.empty())
+		{
+			if (argument.find_first_of(L" \"\t") == argument.npos)
+			{
+				return argument;
+			}
+
+			argument.reserve(argument.length() * 2);
+			auto index{ argument.length() };
+			auto quote{ true };
+
+			while (--index != argument.npos)
+			{
+				if (quote && argument[index] == L'\\')
+				{
+					argument.insert(index, 1, L'\\');
+				}
+				else if (argument[index] == L'"')
+				{
+					argument.insert(index, 1, L'\\');
+					quote = true;
+				}
+				else if (quote == true)
+				{
+					quote = false;
+				}
+			}
+		}
+
+		return std::wstring{ L'"' + argument + L'"' };
+	}
+
+	void BM_EscapeBackslash(benchmark::State& state)
+	{
+		auto str{ BuildPathologicalString() };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::EscapeBackslash(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length() * sizeof(WCHAR)));
+	}
+
+	void BM_InsertEscapeBackslash(benchmark::State& state)
+	{
+		auto str{ BuildPathologicalString() };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(InsertEscapeBackslash(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length() * sizeof(WCHAR)));
+	}
+
+	void BM_EscapeArgument(benchmark::State& state)
+	{
+		auto str{ BuildPathologicalString() };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::EscapeArgument(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length() * sizeof(WCHAR)));
+	}
+
+	void BM_InsertEscapeArgument(benchmark::State& state)
+	{
+		auto str{ BuildPathologicalString() };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(InsertEscapeArgument(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length() * sizeof(WCHAR)));
+	}
+
+}
+
+BENCHMARK(BM_EscapeBackslash);
+BENCHMARK(BM_InsertEscapeBackslash);
+BENCHMARK(BM_EscapeArgument);
+BENCHMARK(BM_InsertEscapeArgument);
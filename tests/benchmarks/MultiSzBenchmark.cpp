@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "PortableHelpers.h"
+
+// Scan and indexing of multi-sz sequences of 10 to 1,000,000 short items by the SIMD scanner and by the previous strlen loops.
+
+namespace
+{
+
+	template <typename T>
+	std::basic_string<T> BuildMultiSz(size_t count)
+	{
+		std::basic_string<T> multiSz{};
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			auto item{ "c:\\dir\\file" + std::to_string(i) + ".txt" };
+			multiSz.append(item.begin(), item.end());
+			multiSz.push_back(0);
+		}
+
+		multiSz.push_back(0);
+		return multiSz;
+	}
+
+	template <typename T>
+	size_t LoopMultiSzSize(const T* pMultiSz)
+	{
+		auto p{ pMultiSz };
+		while (*p)
+		{
+			p += std::char_traits<T>::length(p) + 1;
+		}
+
+		return static_cast<size_t>(p - pMultiSz + 1) * sizeof(T);
+	}
+
+	template <typename T>
+	size_t LoopMultiSzCount(const T* pMultiSz)
+	{
+		size_t count{ 0 };
+		while (*pMultiSz)
+		{
+			++count;
+			pMultiSz += std::char_traits<T>::length(pMultiSz) + 1;
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	void LoopMultiSzOffsets(const T* pMultiSz, std::vector<size_t>& offsets)
+	{
+		offsets.clear();
+
+		auto p{ pMultiSz };
+		while (*p)
+		{
+			offsets.push_back(static_cast<size_t>(p - pMultiSz));
+			p += std::char_traits<T>::length(p) + 1;
+		}
+
+		offsets.push_back(static_cast<size_t>(p - pMultiSz));
+	}
+
+	template <typename T>
+	void SetCounters(benchmark::State& state, const std::basic_string<T>& multiSz)
+	{
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (multiSz.size() + 1) * sizeof(T)));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+	}
+
+	template <typename T>
+	void BM_GetMultiSzSize(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::GetMultiSzSize(multiSz.c_str()));
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+	template <typename T>
+	void BM_LoopMultiSzSize(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(LoopMultiSzSize(multiSz.c_str()));
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+	template <typename T>
+	void BM_GetMultiSzCount(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::GetMultiSzCount(multiSz.c_str()));
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+	template <typename T>
+	void BM_LoopMultiSzCount(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(LoopMultiSzCount(multiSz.c_str()));
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+	template <typename T>
+	void BM_MultiSzIndex(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		hlp::MultiSzIndex<T> index{};
+		for (auto _ : state)
+		{
+			index.Load(multiSz.c_str());
+			benchmark::DoNotOptimize(index.size());
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+	template <typename T>
+	void BM_LoopMultiSzOffsets(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz<T>(static_cast<size_t>(state.range(0))) };
+		std::vector<size_t> offsets{};
+		for (auto _ : state)
+		{
+			LoopMultiSzOffsets(multiSz.c_str(), offsets);
+			benchmark::DoNotOptimize(offsets.data());
+		}
+
+		SetCounters(state, multiSz);
+	}
+
+}
+
+BENCHMARK_TEMPLATE(BM_GetMultiSzSize, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzSize, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_GetMultiSzCount, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzCount, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_GetMultiSzSize, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzSize, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_GetMultiSzCount, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzCount, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_MultiSzIndex, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzOffsets, char)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_MultiSzIndex, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_LoopMultiSzOffsets, WCHAR)->RangeMultiplier(10)->Range(10, 1000000);
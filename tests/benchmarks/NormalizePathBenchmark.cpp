@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "PortableHelpers.h"
+
+// Normalization of a messy absolute path by the single pass function and by a naive split and rejoin.
+
+namespace
+{
+
+	std::wstring BuildMessyPath(size_t length)
+	{
+		std::wstring path{ L"c:\\" };
+		while (path.length() < length)
+		{
+			path += L"dir/./sub\\\\..\\file.txt\\";
+		}
+
+		return path;
+	}
+
+	std::wstring SplitNormalizePath(std::wstring path)
+	{
+		std::replace(path.begin(), path.end(), L'/', L'\\');
+
+		std::vector<std::wstring> components{};
+		size_t start{ 3 };
+		while (start < path.length())
+		{
+			auto end{ (std::min)(path.find(L'\\', start), path.length()) };
+			auto component{ path.substr(start, end - start) };
+
+			if (component == L"..")
+			{
+				if (!components.empty())
+				{
+					components.pop_back();
+				}
+			}
+			else if (!component.empty() && component != L".")
+			{
+				components.push_back(component);
+			}
+
+			start = end + 1;
+		}
+
+		auto result{ path.substr(0, 3) };
+		for (const auto& component : components)
+		{
+			result += component + L'\\';
+		}
+
+		return result;
+	}
+
+	void BM_NormalizePath(benchmark::State& state)
+	{
+		auto path{ BuildMessyPath(static_cast<size_t>(state.range(0))) };
+		auto buffer{ path };
+
+		for (auto _ : state)
+		{
+			std::copy(path.begin(), path.end(), buffer.begin());
+			benchmark::DoNotOptimize(hlp::NormalizePath(&buffer[0], buffer.length()));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.length() * sizeof(WCHAR)));
+	}
+
+	void BM_SplitNormalizePath(benchmark::State& state)
+	{
+		auto path{ BuildMessyPath(static_cast<size_t>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(SplitNormalizePath(path));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * path.length() * sizeof(WCHAR)));
+	}
+
+}
+
+BENCHMARK(BM_NormalizePath)->Arg(64)->Arg(260)->Arg(32 * 1024);
+BENCHMARK(BM_SplitNormalizePath)->Arg(64)->Arg(260)->Arg(32 * 1024);
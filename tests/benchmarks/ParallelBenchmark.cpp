@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "PortableHelpers.h"
+
+// Ordered parallel processing of a drop list with a synthetic per-item workload (hashing rounds over the path),
+// by 1 to 8 worker threads. The small calls show the cost of starting the workers, now reused from the pool.
+
+namespace
+{
+
+	std::vector<BYTE> BuildDropFiles(size_t count)
+	{
+		std::vector<std::wstring> items{};
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			items.push_back(L"c:\\dir\\sub\\file" + std::to_wstring(i) + L".txt");
+		}
+
+		return hlp::MultiSzBuilder{ items }.BuildDropFiles();
+	}
+
+	// Returns : FNV-1a hash of the item repeated for the count of rounds.
+	UINT64 HashItem(std::wstring_view item, int rounds)
+	{
+		UINT64 hash{ 14695981039346656037ull };
+		for (int round{ 0 }; round < rounds; ++round)
+		{
+			for (auto chr : item)
+			{
+				hash = (hash ^ static_cast<UINT64>(chr)) * 1099511628211ull;
+			}
+		}
+
+		return hash;
+	}
+
+	void BM_ParallelForEach(benchmark::State& state)
+	{
+		auto block{ BuildDropFiles(10000) };
+		hlp::DropFilesList list{};
+		list.Load(block.data(), block.size());
+
+		hlp::ParallelOptions options{};
+		options.threadCount = static_cast<size_t>(state.range(0));
+
+		for (auto _ : state)
+		{
+			UINT64 total{ 0 };
+			list.ParallelForEach([](std::wstring_view item) { return HashItem(item, 200); }, [&total](size_t, UINT64 hash) { total ^= hash; }, options);
+			benchmark::DoNotOptimize(total);
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * list.Count()));
+	}
+
+	void BM_ParallelForEachSmallCalls(benchmark::State& state)
+	{
+		auto block{ BuildDropFiles(16) };
+		hlp::DropFilesList list{};
+		list.Load(block.data(), block.size());
+
+		hlp::ParallelOptions options{};
+		options.threadCount = static_cast<size_t>(state.range(0));
+
+		for (auto _ : state)
+		{
+			UINT64 total{ 0 };
+			list.ParallelForEach([](std::wstring_view item) { return HashItem(item, 1); }, [&total](size_t, UINT64 hash) { total ^= hash; }, options);
+			benchmark::DoNotOptimize(total);
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * list.Count()));
+	}
+
+}
+
+BENCHMARK(BM_ParallelForEach)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(BM_ParallelForEachSmallCalls)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
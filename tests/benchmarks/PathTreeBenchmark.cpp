@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+#include "PortableHelpers.h"
+
+// PathTree against a std::set of the full paths, on 10^6 paths (1000 directories of 1000 files) given in drop list
+// order. The bytes counter is the memory held by the container once built (GetMemoryUsage for the tree, the bytes
+// allocated through a counting resource for the set).
+
+namespace
+{
+
+	// Memory resource counting the bytes currently allocated.
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t bytes{ 0 };
+	private:
+		void* do_allocate(size_t bytes_, size_t alignment) override
+		{
+			bytes += bytes_;
+			return std::pmr::new_delete_resource()->allocate(bytes_, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes_, size_t alignment) override
+		{
+			bytes -= bytes_;
+			std::pmr::new_delete_resource()->deallocate(p, bytes_, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	const std::vector<std::wstring>& GetPaths()
+	{
+		static const std::vector<std::wstring> paths{ []
+		{
+			std::vector<std::wstring> paths{};
+			for (int dir{ 0 }; dir < 1000; ++dir)
+			{
+				auto directory{ L"c:\\users\\name\\documents\\project\\dir" + std::to_wstring(dir) + L"\\" };
+				for (int file{ 0 }; file < 1000; ++file)
+				{
+					paths.push_back(directory + L"file" + std::to_wstring(file) + L".txt");
+				}
+			}
+
+			return paths;
+		}() };
+
+		return paths;
+	}
+
+	void BM_PathTreeBuild(benchmark::State& state)
+	{
+		const auto& paths{ GetPaths() };
+		size_t bytes{ 0 };
+
+		for (auto _ : state)
+		{
+			hlp::PathTree tree{};
+			for (const auto& path : paths)
+			{
+				tree.Add(path);
+			}
+
+			bytes = tree.GetMemoryUsage();
+			benchmark::DoNotOptimize(tree.size());
+		}
+
+		state.counters["bytes"] = static_cast<double>(bytes);
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+	}
+
+	void BM_SetBuild(benchmark::State& state)
+	{
+		const auto& paths{ GetPaths() };
+		size_t bytes{ 0 };
+
+		for (auto _ : state)
+		{
+			CountingResource resource{};
+
+			{
+				std::pmr::set<std::pmr::wstring> set{ &resource };
+				for (const auto& path : paths)
+				{
+					set.emplace(path);
+				}
+
+				bytes = resource.bytes;
+				benchmark::DoNotOptimize(set.size());
+			}
+		}
+
+		state.counters["bytes"] = static_cast<double>(bytes);
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * paths.size()));
+	}
+
+	void BM_PathTreeContains(benchmark::State& state)
+	{
+		const auto& paths{ GetPaths() };
+		hlp::PathTree tree{};
+		for (const auto& path : paths)
+		{
+			tree.Add(path);
+		}
+
+		size_t index{ 0 };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(tree.Contains(paths[index]));
+			index = (index + 7919) % paths.size();
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+	}
+
+	void BM_SetContains(benchmark::State& state)
+	{
+		const auto& paths{ GetPaths() };
+		std::set<std::wstring> set(paths.begin(), paths.end());
+
+		size_t index{ 0 };
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(set.count(paths[index]));
+			index = (index + 7919) % paths.size();
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+	}
+
+}
+
+BENCHMARK(BM_PathTreeBuild)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SetBuild)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PathTreeContains);
+BENCHMARK(BM_SetContains);
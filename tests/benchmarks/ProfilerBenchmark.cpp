@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include "PortableHelpers.h"
+
+// Cost of an empty ProfilerScope, with the profiler enabled and disabled, and of the clock reads it is made of.
+
+namespace
+{
+
+	void BM_ProfilerScope(benchmark::State& state)
+	{
+		static hlp::ProfilerProbe probe{ L"ProfilerBenchmark" };
+		hlp::SetProfilerEnabled(state.range(0) != 0);
+
+		for (auto _ : state)
+		{
+			hlp::ProfilerScope scope{ probe };
+			benchmark::ClobberMemory();
+		}
+
+		hlp::SetProfilerEnabled(true);
+	}
+
+	void BM_TscClockNow(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::TscClock::now());
+		}
+	}
+
+	void BM_SteadyClockNow(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+		}
+	}
+
+}
+
+BENCHMARK(BM_ProfilerScope)->ArgName("enabled")->Arg(1)->Arg(0);
+BENCHMARK(BM_TscClockNow);
+BENCHMARK(BM_SteadyClockNow);
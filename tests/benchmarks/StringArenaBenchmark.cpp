@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+#include "PortableHelpers.h"
+
+// Collection of 200k paths into a std::vector<std::wstring> (one allocation per path) and into a StringArena, through
+// GetMultiSzItems and through the loop of DeviceInformationSet::GetDevicePath (collect the paths, then search them).
+// The device enumeration needs SetupAPI, so it is replaced by a walk of a multi-sz holding device interface paths.
+// The allocations counter is the count of operator new calls per iteration, plus the blocks of the arenas (allocated
+// through the aligned operator new by the standard memory resource, so counted by the arena's resource).
+
+namespace
+{
+
+	std::atomic<size_t> allocationCount{ 0 };
+
+}
+
+void* operator new(size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto p{ std::malloc(size != 0 ? size : 1) })
+	{
+		return p;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+
+	constexpr size_t PATH_COUNT{ 200000 };
+
+	// Adds the allocations made through it to the counter.
+	class CountingResource : public std::pmr::memory_resource
+	{
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			allocationCount.fetch_add(1, std::memory_order_relaxed);
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	const std::wstring& GetMultiSz()
+	{
+		static const std::wstring multiSz{ []
+		{
+			std::wstring multiSz{};
+			for (size_t i{ 0 }; i < PATH_COUNT; ++i)
+			{
+				multiSz += L"\\\\?\\usbstor#disk&ven_generic&prod_flash_disk#" + std::to_wstring(i) + L"&0#{53f56307-b6bf-11d0-94f2-00a0c91efb8b}";
+				multiSz += L'\0';
+			}
+
+			return multiSz;
+		}() };
+
+		return multiSz;
+	}
+
+	// Stand-in for DeviceInformationSet::EnumerateDevicePaths.
+	template <typename Callback>
+	void EnumerateDevicePaths(Callback callback)
+	{
+		for (auto item : hlp::MultiSzView<WCHAR>{ GetMultiSz().c_str() })
+		{
+			callback(item.data());
+		}
+	}
+
+	void SetAllocationCounter(benchmark::State& state, size_t allocations)
+	{
+		state.counters["allocations"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * PATH_COUNT));
+	}
+
+	void BM_GetMultiSzItemsVector(benchmark::State& state)
+	{
+		auto pMultiSz{ GetMultiSz().c_str() };
+		auto start{ allocationCount.load() };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::GetMultiSzItems(pMultiSz).size());
+		}
+
+		SetAllocationCounter(state, allocationCount.load() - start);
+	}
+
+	void BM_GetMultiSzItemsArena(benchmark::State& state)
+	{
+		auto pMultiSz{ GetMultiSz().c_str() };
+		CountingResource resource{};
+		auto start{ allocationCount.load() };
+
+		for (auto _ : state)
+		{
+			hlp::StringArena items{ &resource };
+			hlp::GetMultiSzItems(pMultiSz, items);
+			benchmark::DoNotOptimize(items.size());
+		}
+
+		SetAllocationCounter(state, allocationCount.load() - start);
+	}
+
+	// The last path matches, like a device found at the end of the enumeration.
+	void BM_GetDevicePathVector(benchmark::State& state)
+	{
+		auto target{ std::to_wstring(PATH_COUNT - 1) + L"&0#" };
+		auto start{ allocationCount.load() };
+
+		for (auto _ : state)
+		{
+			std::vector<std::wstring> devicePaths{};
+			EnumerateDevicePaths([&devicePaths](LPCWSTR pDevicePath) { devicePaths.push_back(std::wstring{ pDevicePath }); });
+
+			std::wstring devicePath{};
+			for (const auto& path : devicePaths)
+			{
+				if (path.find(target) != std::wstring::npos)
+				{
+					devicePath = path;
+					break;
+				}
+			}
+
+			benchmark::DoNotOptimize(devicePath.length());
+		}
+
+		SetAllocationCounter(state, allocationCount.load() - start);
+	}
+
+	void BM_GetDevicePathArena(benchmark::State& state)
+	{
+		auto target{ std::to_wstring(PATH_COUNT - 1) + L"&0#" };
+		CountingResource resource{};
+		auto start{ allocationCount.load() };
+
+		for (auto _ : state)
+		{
+			hlp::StringArena devicePaths{ &resource };
+			EnumerateDevicePaths([&devicePaths](LPCWSTR pDevicePath) { devicePaths.Add(pDevicePath); });
+
+			std::wstring devicePath{};
+			for (const auto& path : devicePaths)
+			{
+				if (path.find(target) != std::wstring_view::npos)
+				{
+					devicePath = std::wstring{ path };
+					break;
+				}
+			}
+
+			benchmark::DoNotOptimize(devicePath.length());
+		}
+
+		SetAllocationCounter(state, allocationCount.load() - start);
+	}
+
+}
+
+BENCHMARK(BM_GetMultiSzItemsVector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetMultiSzItemsArena)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetDevicePathVector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetDevicePathArena)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "PortableHelpers.h"
+
+// UTF-8 to UTF-16 and UTF-16 to UTF-8 conversions of 256 B and 64 KB strings, in ASCII only and in a mix of scripts
+// (ASCII, Latin accents, Cyrillic, CJK and characters outside the BMP, so one to four bytes per character).
+
+namespace
+{
+
+	std::string BuildUtf8String(size_t length, bool mixed)
+	{
+		constexpr const char* ASCII{ "c:\\dir\\file.txt " };
+		constexpr const char* MIXED{ u8"c:\\dir\\r\u00E9sum\u00E9 \u0444\u0430\u0439\u043B \u6587\u4EF6 \U0001F4C1 " };
+
+		std::string str{};
+		while (str.length() < length)
+		{
+			str += mixed ? MIXED : ASCII;
+		}
+
+		return str;
+	}
+
+	void BM_Utf8ToUtf16(benchmark::State& state, bool mixed)
+	{
+		auto str{ BuildUtf8String(static_cast<size_t>(state.range(0)), mixed) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::Utf8ToUtf16(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length()));
+	}
+
+	void BM_Utf16ToUtf8(benchmark::State& state, bool mixed)
+	{
+		auto str{ hlp::Utf8ToUtf16(BuildUtf8String(static_cast<size_t>(state.range(0)), mixed)) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::Utf16ToUtf8(str));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length() * sizeof(WCHAR)));
+	}
+
+}
+
+BENCHMARK_CAPTURE(BM_Utf8ToUtf16, Ascii, false)->Arg(256)->Arg(64 * 1024);
+BENCHMARK_CAPTURE(BM_Utf8ToUtf16, Mixed, true)->Arg(256)->Arg(64 * 1024);
+BENCHMARK_CAPTURE(BM_Utf16ToUtf8, Ascii, false)->Arg(256)->Arg(64 * 1024);
+BENCHMARK_CAPTURE(BM_Utf16ToUtf8, Mixed, true)->Arg(256)->Arg(64 * 1024);
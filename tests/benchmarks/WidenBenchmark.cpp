@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include "PortableHelpers.h"
+
+// Widening of Latin-1 strings of 16 B, 256 B and 64 KB by the SIMD kernel and by the iterator constructor used before.
+
+namespace
+{
+
+	std::string BuildLatin1String(size_t length)
+	{
+		std::string str(length, '\0');
+		for (size_t i{ 0 }; i < length; ++i)
+		{
+			str[i] = static_cast<char>(0x20 + i % 0xD0);
+		}
+
+		return str;
+	}
+
+	void BM_WidenString(benchmark::State& state)
+	{
+		auto str{ BuildLatin1String(static_cast<size_t>(state.range(0))) };
+		std::wstring wideStr(str.length(), L'\0');
+
+		for (auto _ : state)
+		{
+			hlp::WidenString(str.data(), str.length(), &wideStr[0]);
+			benchmark::ClobberMemory();
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length()));
+	}
+
+	void BM_WStrFromStr(benchmark::State& state)
+	{
+		auto str{ BuildLatin1String(static_cast<size_t>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::WStrFromStr(str.c_str()));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length()));
+	}
+
+	void BM_IteratorConstructor(benchmark::State& state)
+	{
+		auto str{ BuildLatin1String(static_cast<size_t>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			auto pStr{ reinterpret_cast<const unsigned char*>(str.c_str()) };
+			benchmark::DoNotOptimize(std::wstring(pStr, pStr + std::strlen(str.c_str())));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.length()));
+	}
+
+	std::string BuildMultiSz(size_t length)
+	{
+		std::string multiSz{};
+		while (multiSz.length() < length)
+		{
+			multiSz += "c:\\dir\\file.txt";
+			multiSz += '\0';
+		}
+
+		multiSz += '\0';
+		return multiSz;
+	}
+
+	void BM_GetMultiSzItemsWide(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz(static_cast<size_t>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(hlp::GetMultiSzItemsWide(multiSz.c_str()));
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * multiSz.length()));
+	}
+
+	void BM_IteratorMultiSzItems(benchmark::State& state)
+	{
+		auto multiSz{ BuildMultiSz(static_cast<size_t>(state.range(0))) };
+
+		for (auto _ : state)
+		{
+			std::vector<std::wstring> items{};
+			for (auto pItem{ multiSz.c_str() }; *pItem; )
+			{
+				auto length{ std::strlen(pItem) };
+				items.push_back(std::wstring(pItem, pItem + length));
+				pItem += length + 1;
+			}
+
+			benchmark::DoNotOptimize(items);
+		}
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * multiSz.length()));
+	}
+
+}
+
+BENCHMARK(BM_WidenString)->Arg(16)->Arg(256)->Arg(64 * 1024);
+BENCHMARK(BM_WStrFromStr)->Arg(16)->Arg(256)->Arg(64 * 1024);
+BENCHMARK(BM_IteratorConstructor)->Arg(16)->Arg(256)->Arg(64 * 1024);
+BENCHMARK(BM_GetMultiSzItemsWide)->Arg(256)->Arg(64 * 1024);
+BENCHMARK(BM_IteratorMultiSzItems)->Arg(256)->Arg(64 * 1024);